@@ -0,0 +1,224 @@
+// broadphase 网格基准：对同一组随机 AABB，分别用 CellGrid（当前实现）与 user-004 之前的
+// unordered_map<格子键, vector<下标>> 网格构建并枚举候选对，报告每帧耗时与网格内存。
+// 两种网格使用完全相同的遍历与重叠判断，候选对数量必须一致，否则以非 0 退出。
+//
+// 用法：broadphase_bench [frames_scale]，frames_scale 默认为 1，数值越大重复帧数越多、结果越稳定。
+#include "cell_grid.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+struct Box {
+	float min_x, min_y, max_x, max_y;
+};
+
+constexpr float kCellSize = 64.0f; // 与 PhysicsSystem::Step 的默认格子尺寸一致
+
+struct CellRange {
+	int32_t gx0, gy0, gx1, gy1;
+};
+
+CellRange cell_range(const Box& b) noexcept
+{
+	return CellRange{
+		static_cast<int32_t>(std::floor(b.min_x / kCellSize)),
+		static_cast<int32_t>(std::floor(b.min_y / kCellSize)),
+		static_cast<int32_t>(std::floor(b.max_x / kCellSize)),
+		static_cast<int32_t>(std::floor(b.max_y / kCellSize)) };
+}
+
+bool overlap(const Box& a, const Box& b) noexcept
+{
+	return a.min_x <= b.max_x && b.min_x <= a.max_x && a.min_y <= b.max_y && b.min_y <= a.max_y;
+}
+
+// 平均每 48x48 像素一个物体，尺寸 8~40 像素：与房间中砖块/尖刺/子弹混合时的密度相当
+std::vector<Box> make_boxes(size_t n, uint32_t seed)
+{
+	std::mt19937 rng(seed);
+	const float side = std::sqrt(static_cast<float>(n)) * 48.0f;
+	std::uniform_real_distribution<float> pos(-side * 0.5f, side * 0.5f);
+	std::uniform_real_distribution<float> ext(4.0f, 20.0f);
+	std::vector<Box> boxes(n);
+	for (Box& b : boxes) {
+		const float cx = pos(rng), cy = pos(rng);
+		const float hx = ext(rng), hy = ext(rng);
+		b = Box{ cx - hx, cy - hy, cx + hx, cy + hy };
+	}
+	return boxes;
+}
+
+// user-004 之前的运动网格（见 4920d4e 的 PhysicsSystem::Step）：桶在帧间保留，帧首清空用过的桶
+struct LegacyHashGrid {
+	std::unordered_map<uint64_t, std::vector<size_t>> grid;
+	std::vector<uint64_t> keys_used;
+	std::vector<CellRange> ranges;
+
+	static uint64_t key(int32_t x, int32_t y) noexcept
+	{
+		return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint64_t>(static_cast<uint32_t>(y));
+	}
+
+	void Build(const std::vector<Box>& boxes)
+	{
+		for (uint64_t k : keys_used) {
+			auto it = grid.find(k);
+			if (it != grid.end()) it->second.clear();
+		}
+		keys_used.clear();
+		ranges.resize(boxes.size());
+		for (size_t i = 0; i < boxes.size(); ++i) {
+			const CellRange r = cell_range(boxes[i]);
+			ranges[i] = r;
+			for (int32_t gx = r.gx0; gx <= r.gx1; ++gx) {
+				for (int32_t gy = r.gy0; gy <= r.gy1; ++gy) {
+					const uint64_t k = key(gx, gy);
+					grid[k].push_back(i);
+					keys_used.push_back(k);
+				}
+			}
+		}
+	}
+
+	size_t CountPairs(const std::vector<Box>& boxes) const
+	{
+		size_t pairs = 0;
+		for (size_t i = 0; i < boxes.size(); ++i) {
+			const CellRange& r = ranges[i];
+			for (int32_t gx = r.gx0; gx <= r.gx1; ++gx) {
+				for (int32_t gy = r.gy0; gy <= r.gy1; ++gy) {
+					auto it = grid.find(key(gx, gy));
+					if (it == grid.end()) continue;
+					for (size_t j : it->second) {
+						if (j <= i) continue;
+						if (overlap(boxes[i], boxes[j])) ++pairs;
+					}
+				}
+			}
+		}
+		return pairs;
+	}
+
+	// 估算：桶数组 + 每个节点（键 + vector 头 + 链表指针）+ 各 vector 的容量 + keys_used
+	size_t EstimatedBytes() const
+	{
+		size_t total = grid.bucket_count() * sizeof(void*);
+		total += grid.size() * (sizeof(uint64_t) + sizeof(std::vector<size_t>) + sizeof(void*));
+		for (const auto& kv : grid) total += kv.second.capacity() * sizeof(size_t);
+		total += keys_used.capacity() * sizeof(uint64_t) + ranges.capacity() * sizeof(CellRange);
+		return total;
+	}
+};
+
+// 当前实现：CellGrid 的 counting sort 构建
+struct FlatGrid {
+	CellGrid grid;
+	std::vector<CellRange> ranges;
+
+	void Build(const std::vector<Box>& boxes)
+	{
+		grid.Begin(boxes.size() * 2);
+		ranges.resize(boxes.size());
+		for (size_t i = 0; i < boxes.size(); ++i) {
+			const CellRange r = cell_range(boxes[i]);
+			ranges[i] = r;
+			for (int32_t gx = r.gx0; gx <= r.gx1; ++gx) {
+				for (int32_t gy = r.gy0; gy <= r.gy1; ++gy) {
+					grid.Add(gx, gy, static_cast<uint32_t>(i));
+				}
+			}
+		}
+		grid.Finalize();
+	}
+
+	size_t CountPairs(const std::vector<Box>& boxes) const
+	{
+		size_t pairs = 0;
+		for (size_t i = 0; i < boxes.size(); ++i) {
+			const CellRange& r = ranges[i];
+			for (int32_t gx = r.gx0; gx <= r.gx1; ++gx) {
+				for (int32_t gy = r.gy0; gy <= r.gy1; ++gy) {
+					for (uint32_t j : grid.Query(gx, gy)) {
+						if (j <= i) continue;
+						if (overlap(boxes[i], boxes[j])) ++pairs;
+					}
+				}
+			}
+		}
+		return pairs;
+	}
+
+	size_t EstimatedBytes() const { return grid.GetEstimatedMemoryUsageBytes() + ranges.capacity() * sizeof(CellRange); }
+};
+
+struct Timing {
+	double build_us = 0.0; // 每帧构建耗时（中位数）
+	double total_us = 0.0; // 每帧构建 + 枚举候选对耗时（中位数）
+	size_t pairs = 0;
+	size_t bytes = 0;
+};
+
+double median(std::vector<double>& v)
+{
+	std::sort(v.begin(), v.end());
+	return v[v.size() / 2];
+}
+
+template <typename Grid>
+Timing run(const std::vector<Box>& boxes, int frames)
+{
+	using clock = std::chrono::steady_clock;
+	Grid g;
+	Timing t;
+	std::vector<double> build, total;
+	// 第一帧用于预热（两种网格的容器都会在此分配并在之后复用）
+	for (int f = 0; f <= frames; ++f) {
+		const auto t0 = clock::now();
+		g.Build(boxes);
+		const auto t1 = clock::now();
+		t.pairs = g.CountPairs(boxes);
+		const auto t2 = clock::now();
+		if (f == 0) continue;
+		build.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+		total.push_back(std::chrono::duration<double, std::micro>(t2 - t0).count());
+	}
+	t.build_us = median(build);
+	t.total_us = median(total);
+	t.bytes = g.EstimatedBytes();
+	return t;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	const int scale = argc > 1 ? std::max(1, std::atoi(argv[1])) : 1;
+	const size_t counts[] = { 1000, 10000, 50000 };
+	const int frames[] = { 200, 40, 10 };
+
+	std::printf("broadphase grid: cell = %.0f px, median per frame\n", kCellSize);
+	std::printf("%8s | %-14s | %10s | %10s | %8s | %10s\n", "bodies", "grid", "build us", "total us", "pairs", "bytes");
+	int status = 0;
+	for (size_t k = 0; k < 3; ++k) {
+		const std::vector<Box> boxes = make_boxes(counts[k], 1234u + static_cast<uint32_t>(k));
+		const Timing legacy = run<LegacyHashGrid>(boxes, frames[k] * scale);
+		const Timing flat = run<FlatGrid>(boxes, frames[k] * scale);
+		std::printf("%8zu | %-14s | %10.1f | %10.1f | %8zu | %10zu\n", counts[k], "unordered_map", legacy.build_us, legacy.total_us, legacy.pairs, legacy.bytes);
+		std::printf("%8zu | %-14s | %10.1f | %10.1f | %8zu | %10zu\n", counts[k], "CellGrid", flat.build_us, flat.total_us, flat.pairs, flat.bytes);
+		std::printf("%8s | speedup build x%.2f, total x%.2f\n", "", legacy.build_us / flat.build_us, legacy.total_us / flat.total_us);
+		if (legacy.pairs != flat.pairs) {
+			std::printf("MISMATCH: candidate pair counts differ\n");
+			status = 1;
+		}
+	}
+	return status;
+}
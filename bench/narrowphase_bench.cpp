@@ -0,0 +1,183 @@
+// 瓦片地图 narrowphase 基准：玩家 AABB 与尖刺三角形（AABB-多边形）的候选对，比较三条路径：
+// - cf_collide：user-013 之前的通用路径
+// - reject + cf_collide：user-013 最初的实现（分离轴剔除，未剔除时仍调用 cf_collide）
+// - CollideShapes：当前分派表中的直接 AABB-多边形内核
+// 候选对与 broadphase 一致（包围盒重叠），同时核对直接内核与 cf_collide 的命中、法线与深度是否一致。
+//
+// 用法：narrowphase_bench [repeat]，repeat 默认为 20。
+#include "base_physics.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr float kTile = 36.0f;
+
+// user-013 最初版本的分离轴剔除（见 Collider.cpp 的历史版本），只用于对照
+constexpr float POLY_REJECT_EPS = 1e-4f;
+bool aabb_poly_separated(const CF_Aabb& box, const CF_Poly& poly) noexcept
+{
+	const int count = poly.count;
+	const CF_V2* v = poly.verts;
+	float minx = v[0].x, maxx = v[0].x, miny = v[0].y, maxy = v[0].y;
+	for (int i = 1; i < count; ++i) {
+		minx = std::min(minx, v[i].x); maxx = std::max(maxx, v[i].x);
+		miny = std::min(miny, v[i].y); maxy = std::max(maxy, v[i].y);
+	}
+	if (maxx < box.min.x - POLY_REJECT_EPS || minx > box.max.x + POLY_REJECT_EPS) return true;
+	if (maxy < box.min.y - POLY_REJECT_EPS || miny > box.max.y + POLY_REJECT_EPS) return true;
+	const float cx = (box.min.x + box.max.x) * 0.5f, cy = (box.min.y + box.max.y) * 0.5f;
+	const float hx = (box.max.x - box.min.x) * 0.5f, hy = (box.max.y - box.min.y) * 0.5f;
+	for (int i = 0; i < count; ++i) {
+		const CF_V2 e = v[i + 1 < count ? i + 1 : 0] - v[i];
+		const float nx = -e.y, ny = e.x;
+		float pmin = nx * v[0].x + ny * v[0].y;
+		float pmax = pmin;
+		for (int k = 1; k < count; ++k) {
+			const float d = nx * v[k].x + ny * v[k].y;
+			pmin = std::min(pmin, d);
+			pmax = std::max(pmax, d);
+		}
+		const float c = nx * cx + ny * cy;
+		const float r = std::fabs(nx) * hx + std::fabs(ny) * hy;
+		const float eps = POLY_REJECT_EPS * (std::fabs(nx) + std::fabs(ny));
+		if (c + r < pmin - eps || c - r > pmax + eps) return true;
+	}
+	return false;
+}
+
+// 与 Spike 相同的 32 像素三角形，四个朝向，放在瓦片中心
+CF_Poly make_spike(CF_V2 c, int dir)
+{
+	CF_V2 v[3] = { { -16.0f, -16.0f }, { 16.0f, -16.0f }, { 0.0f, 16.0f } };
+	CF_Poly p{};
+	p.count = 3;
+	for (int i = 0; i < 3; ++i) {
+		CF_V2 r = v[i];
+		for (int k = 0; k < dir; ++k) r = cf_v2(-r.y, r.x);
+		p.verts[i] = c + r;
+	}
+	cf_make_poly(&p);
+	return p;
+}
+
+CF_Aabb poly_bounds(const CF_Poly& p)
+{
+	CF_Aabb b{ p.verts[0], p.verts[0] };
+	for (int i = 1; i < p.count; ++i) {
+		b.min = cf_v2(std::min(b.min.x, p.verts[i].x), std::min(b.min.y, p.verts[i].y));
+		b.max = cf_v2(std::max(b.max.x, p.verts[i].x), std::max(b.max.y, p.verts[i].y));
+	}
+	return b;
+}
+
+bool overlap(const CF_Aabb& a, const CF_Aabb& b)
+{
+	return a.min.x <= b.max.x && b.min.x <= a.max.x && a.min.y <= b.max.y && b.min.y <= a.max.y;
+}
+
+struct Candidate {
+	CF_ShapeWrapper box;
+	CF_ShapeWrapper spike;
+};
+
+// 40x30 格的房间，约 30% 的格子放尖刺；玩家 AABB（半宽 9、半高 10.5）随机落在房间内，
+// 只保留包围盒与尖刺重叠的候选对，即 broadphase 交给 narrowphase 的输入
+std::vector<Candidate> make_candidates(size_t target)
+{
+	std::mt19937 rng(20261016u);
+	std::vector<CF_Poly> spikes;
+	std::vector<CF_Aabb> bounds;
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+	for (int y = 0; y < 30; ++y) {
+		for (int x = 0; x < 40; ++x) {
+			if (unit(rng) > 0.3f) continue;
+			spikes.push_back(make_spike(cf_v2((x + 0.5f) * kTile, (y + 0.5f) * kTile), static_cast<int>(rng() % 4)));
+			bounds.push_back(poly_bounds(spikes.back()));
+		}
+	}
+
+	std::vector<Candidate> out;
+	std::uniform_real_distribution<float> px(0.0f, 40.0f * kTile), py(0.0f, 30.0f * kTile);
+	while (out.size() < target) {
+		const CF_V2 c = cf_v2(px(rng), py(rng));
+		const CF_Aabb box{ cf_v2(c.x - 9.0f, c.y - 10.5f), cf_v2(c.x + 9.0f, c.y + 10.5f) };
+		for (size_t i = 0; i < spikes.size() && out.size() < target; ++i) {
+			if (overlap(box, bounds[i])) out.push_back(Candidate{ CF_ShapeWrapper::FromAabb(box), CF_ShapeWrapper::FromPoly(spikes[i]) });
+		}
+	}
+	return out;
+}
+
+template <typename Fn>
+double time_ns_per_test(const std::vector<Candidate>& cands, int repeat, size_t& hits, Fn&& fn)
+{
+	using clock = std::chrono::steady_clock;
+	std::vector<double> runs;
+	for (int r = 0; r <= repeat; ++r) {
+		size_t h = 0;
+		const auto t0 = clock::now();
+		for (const Candidate& c : cands) {
+			CF_Manifold m{};
+			if (fn(c, m)) ++h;
+		}
+		const auto t1 = clock::now();
+		hits = h;
+		if (r > 0) runs.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(cands.size()));
+	}
+	std::sort(runs.begin(), runs.end());
+	return runs[runs.size() / 2];
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	const int repeat = argc > 1 ? std::max(1, std::atoi(argv[1])) : 20;
+	const std::vector<Candidate> cands = make_candidates(100000);
+
+	auto generic = [](const Candidate& c, CF_Manifold& m) {
+		cf_collide(&c.box.u, nullptr, c.box.type, &c.spike.u, nullptr, c.spike.type, &m);
+		return m.count > 0;
+	};
+	auto reject_then_generic = [&](const Candidate& c, CF_Manifold& m) {
+		if (aabb_poly_separated(c.box.u.aabb, c.spike.u.poly)) return false;
+		return generic(c, m);
+	};
+	auto direct = [](const Candidate& c, CF_Manifold& m) {
+		return PhysicsSystem::CollideShapes(ShapeView::Of(c.box), ShapeView::Of(c.spike), &m);
+	};
+
+	size_t h_generic = 0, h_reject = 0, h_direct = 0;
+	const double t_generic = time_ns_per_test(cands, repeat, h_generic, generic);
+	const double t_reject = time_ns_per_test(cands, repeat, h_reject, reject_then_generic);
+	const double t_direct = time_ns_per_test(cands, repeat, h_direct, direct);
+
+	// 一致性：命中集合、法线与最大深度
+	size_t mismatched_hits = 0, mismatched_manifolds = 0;
+	for (const Candidate& c : cands) {
+		CF_Manifold a{}, b{};
+		const bool ha = generic(c, a);
+		const bool hb = direct(c, b);
+		if (ha != hb) { ++mismatched_hits; continue; }
+		if (!ha) continue;
+		float da = 0.0f, db = 0.0f;
+		for (int i = 0; i < a.count; ++i) da = std::max(da, a.depths[i]);
+		for (int i = 0; i < b.count; ++i) db = std::max(db, b.depths[i]);
+		if (std::fabs(a.n.x - b.n.x) > 1e-3f || std::fabs(a.n.y - b.n.y) > 1e-3f || std::fabs(da - db) > 1e-2f) ++mismatched_manifolds;
+	}
+
+	std::printf("tile-map AABB vs spike: %zu broadphase candidates, median of %d runs\n", cands.size(), repeat);
+	std::printf("%-22s | %10s | %8s | %8s\n", "path", "ns/test", "hits", "speedup");
+	std::printf("%-22s | %10.1f | %8zu | %8s\n", "cf_collide", t_generic, h_generic, "x1.00");
+	std::printf("%-22s | %10.1f | %8zu | x%7.2f\n", "reject + cf_collide", t_reject, h_reject, t_generic / t_reject);
+	std::printf("%-22s | %10.1f | %8zu | x%7.2f\n", "CollideShapes (direct)", t_direct, h_direct, t_generic / t_direct);
+	std::printf("direct vs cf_collide: %zu hit mismatches, %zu normal/depth mismatches\n", mismatched_hits, mismatched_manifolds);
+	return mismatched_hits == 0 ? 0 : 1;
+}
@@ -0,0 +1,130 @@
+// 房间重生（R 键 / 房间切换）基准：建立 N 个对象的房间（85% 静态瓦片、15% 与瓦片接触的动态体，全部注册绘制序列），
+// 然后分别用两种方式拆除，报告每次拆除的耗时（中位数）：
+// - DestroyAll：当前的整体拆除（PhysicsSystem::Clear + DrawingSequence::Clear + OnDestroy/析构扫描）
+// - per-object：user-022 之前的逐个拆除路径，对每个对象 Destroy 后由 UpdateAll 的销毁阶段逐个执行
+//   Unregister（派发 Exit）、OnDestroy 与析构（DrawingSequence::Unregister 线性查表）；
+//   扣除同一房间一次不销毁任何对象的 UpdateAll 耗时
+//
+// 用法：respawn_bench [rounds]，rounds 默认为 15。
+#include "base_object.h"
+#include "drawing_sequence.h"
+#include "obj_manager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+constexpr float kTile = 36.0f;
+
+class BenchObject : public BaseObject {
+public:
+	ObjManager::ObjToken Token() const noexcept { return GetObjToken(); }
+};
+
+std::vector<BenchObject*> g_started; // 本轮创建的对象，提交后从中取得真实 token
+
+class BenchTile : public BenchObject {
+public:
+	explicit BenchTile(CF_V2 pos) noexcept : pos_(pos) {}
+	void Start() override
+	{
+		SpriteSetSource("/sprites/block1.png", 1);
+		SetCenteredAabb(kTile * 0.5f, kTile * 0.5f);
+		SetBodyKind(BodyKind::STATIC);
+		SetPosition(pos_);
+		g_started.push_back(this);
+	}
+private:
+	CF_V2 pos_;
+};
+
+class BenchBody : public BenchObject {
+public:
+	explicit BenchBody(CF_V2 pos) noexcept : pos_(pos) {}
+	void Start() override
+	{
+		SpriteSetSource("/sprites/blood.png", 1);
+		SetCenteredAabb(6.0f, 6.0f);
+		SetBodyKind(BodyKind::DYNAMIC);
+		SetPosition(pos_);
+		g_started.push_back(this);
+	}
+	void OnCollisionEnter(const ObjManager::ObjToken& other, const CF_Manifold& manifold) noexcept override { (void)other; (void)manifold; }
+private:
+	CF_V2 pos_;
+};
+
+// 建立房间：瓦片铺成正方形，每个动态体放在某个瓦片的上边缘，提交后再走一帧使接触与 manifold 缓存建立
+void build_room(size_t n)
+{
+	ObjManager& objs = ObjManager::Instance();
+	g_started.clear();
+	const size_t bodies = n * 15 / 100;
+	const size_t tiles = n - bodies;
+	size_t cols = 1;
+	while (cols * cols < tiles) ++cols;
+	for (size_t i = 0; i < tiles; ++i) {
+		objs.Create<BenchTile>(cf_v2((static_cast<float>(i % cols) + 0.5f) * kTile, (static_cast<float>(i / cols) + 0.5f) * kTile));
+	}
+	for (size_t i = 0; i < bodies; ++i) {
+		const size_t t = (i * 7919) % tiles;
+		objs.Create<BenchBody>(cf_v2((static_cast<float>(t % cols) + 0.5f) * kTile, (static_cast<float>(t / cols) + 1.0f) * kTile + 4.0f));
+	}
+	objs.UpdateAll();
+	objs.UpdateAll();
+}
+
+double elapsed_us(std::chrono::steady_clock::time_point a, std::chrono::steady_clock::time_point b)
+{
+	return std::chrono::duration<double, std::micro>(b - a).count();
+}
+
+double median(std::vector<double>& v)
+{
+	std::sort(v.begin(), v.end());
+	return v[v.size() / 2];
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	using clock = std::chrono::steady_clock;
+	const int rounds = argc > 1 ? std::max(1, std::atoi(argv[1])) : 15;
+	const size_t counts[] = { 600, 1200, 5000 };
+	ObjManager& objs = ObjManager::Instance();
+
+	std::printf("room respawn teardown, median of %d rounds (us)\n", rounds);
+	std::printf("%8s | %10s | %12s | %10s\n", "objects", "DestroyAll", "per-object", "speedup");
+	for (size_t n : counts) {
+		std::vector<double> bulk, per_object;
+		for (int r = 0; r <= rounds; ++r) {
+			build_room(n);
+			const auto b0 = clock::now();
+			objs.DestroyAll();
+			const auto b1 = clock::now();
+
+			build_room(n);
+			std::vector<ObjManager::ObjToken> tokens;
+			for (BenchObject* o : g_started) tokens.push_back(o->Token());
+			const auto u0 = clock::now();
+			objs.UpdateAll();
+			const auto u1 = clock::now();
+			for (const ObjManager::ObjToken& t : tokens) objs.Destroy(t);
+			objs.UpdateAll();
+			const auto u2 = clock::now();
+			objs.DestroyAll();
+
+			if (r == 0) continue; // 第一轮用于预热类型对象池与各容器
+			bulk.push_back(elapsed_us(b0, b1));
+			per_object.push_back(std::max(0.0, elapsed_us(u1, u2) - elapsed_us(u0, u1)));
+		}
+		const double t_bulk = median(bulk), t_per = median(per_object);
+		std::printf("%8zu | %10.1f | %12.1f | x%9.2f\n", n, t_bulk, t_per, t_per / t_bulk);
+	}
+	return 0;
+}
@@ -0,0 +1,335 @@
+// world-space 形状存储基准：PhysicsSystem::Step 中读写形状缓存的热循环，比较 user-015 之前的
+// std::vector<CF_ShapeWrapper> + std::vector<CF_Aabb>（每条目一个按 8 顶点多边形大小的包装）与当前的 WorldShapeStore（SoA）。
+// 每帧依次执行与 Step 相同的四段：
+// 1. 写入：把每个运动条目的 world shape 与 AABB 写入缓存
+// 2. broadphase：GridBroadphase::CollectPairs 读取 AABB 列
+// 3. 批量 AABB 测试：按候选对收集双方 AABB 到 AabbPairBatch 并测试重叠
+// 4. narrowphase 取形状：对重叠的候选对取得双方 ShapeView 并读取其中的数据（不含碰撞计算本身）
+// 报告每帧耗时（中位数）、每帧触及的 64 字节缓存行数与存储占用；两种布局的读取校验和必须一致，否则以非 0 退出。
+// 缓存行数按真实地址统计；WorldShapeStore 的类型列与槽位列是私有成员，按下标与元素大小推算（假设数组按 64 字节对齐）。
+//
+// 用法：world_shape_bench [frames_scale]，frames_scale 默认为 1。
+#include "aabb_batch.h"
+#include "base_physics.h"
+#include "broadphase.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+constexpr float kTile = 36.0f;
+constexpr size_t kLine = 64;
+
+CF_Aabb shape_bounds(const CF_ShapeWrapper& s)
+{
+	if (s.type == CF_SHAPE_TYPE_AABB) return s.u.aabb;
+	const CF_Poly& p = s.u.poly;
+	CF_Aabb b{ p.verts[0], p.verts[0] };
+	for (int i = 1; i < p.count; ++i) {
+		b.min = cf_v2(std::min(b.min.x, p.verts[i].x), std::min(b.min.y, p.verts[i].y));
+		b.max = cf_v2(std::max(b.max.x, p.verts[i].x), std::max(b.max.y, p.verts[i].y));
+	}
+	return b;
+}
+
+// 与 Spike 相同的 32 像素三角形
+CF_ShapeWrapper make_spike(CF_V2 c)
+{
+	CF_Poly p{};
+	p.count = 3;
+	p.verts[0] = c + cf_v2(-16.0f, -16.0f);
+	p.verts[1] = c + cf_v2(16.0f, -16.0f);
+	p.verts[2] = c + cf_v2(0.0f, 16.0f);
+	cf_make_poly(&p);
+	return CF_ShapeWrapper::FromPoly(p);
+}
+
+CF_ShapeWrapper make_box(CF_V2 c, float hx, float hy)
+{
+	return CF_ShapeWrapper::FromAabb(CF_Aabb{ cf_v2(c.x - hx, c.y - hy), cf_v2(c.x + hx, c.y + hy) });
+}
+
+// 场景：n 个静态瓦片（80% 方块、20% 尖刺）铺在 36 像素格子上，n 个运动条目（80% AABB、20% 移动尖刺）随机分布；
+// 运动条目准备两帧位置（相差 1 像素），逐帧交替写入，保证写入阶段每帧都改变数据
+struct Scene {
+	std::vector<CF_ShapeWrapper> statics;
+	std::vector<CF_ShapeWrapper> moving[2];
+};
+
+Scene make_scene(size_t n, uint32_t seed)
+{
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+	Scene s;
+	const int cols = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(n) * 2.0f)));
+	const float side = cols * kTile;
+	for (int y = 0; s.statics.size() < n; ++y) {
+		for (int x = 0; x < cols && s.statics.size() < n; ++x) {
+			if (unit(rng) > 0.5f) continue;
+			const CF_V2 c = cf_v2((x + 0.5f) * kTile, (y % cols + 0.5f) * kTile);
+			s.statics.push_back(unit(rng) < 0.8f ? make_box(c, kTile * 0.5f, kTile * 0.5f) : make_spike(c));
+		}
+	}
+	std::uniform_real_distribution<float> pos(0.0f, side), ext(4.0f, 20.0f);
+	for (size_t i = 0; i < n; ++i) {
+		const CF_V2 c = cf_v2(pos(rng), pos(rng));
+		const bool spike = unit(rng) < 0.2f;
+		const float hx = ext(rng), hy = ext(rng);
+		for (int f = 0; f < 2; ++f) {
+			const CF_V2 cf = c + cf_v2(static_cast<float>(f), 0.0f);
+			s.moving[f].push_back(spike ? make_spike(cf) : make_box(cf, hx, hy));
+		}
+	}
+	return s;
+}
+
+float payload_sum(const ShapeView& v)
+{
+	if (v.type == CF_SHAPE_TYPE_AABB) return v.aabb().min.x + v.aabb().max.y;
+	if (v.type == CF_SHAPE_TYPE_POLY) return v.poly().verts[0].x + v.poly().norms[0].y;
+	return 0.0f;
+}
+
+// user-015 之前的布局：形状与 AABB 各一个 vector，下标即运动/静态分区下标
+struct LegacyShapes {
+	std::vector<CF_ShapeWrapper> shapes;
+	std::vector<CF_Aabb> aabbs;
+
+	void Resize(size_t n) { shapes.resize(n); aabbs.resize(n); }
+	void Set(size_t i, const CF_ShapeWrapper& s, const CF_Aabb& b) { shapes[i] = s; aabbs[i] = b; }
+	const std::vector<CF_Aabb>& Aabbs() const noexcept { return aabbs; }
+	const CF_Aabb& Aabb(size_t i) const noexcept { return aabbs[i]; }
+	ShapeView View(size_t i) const noexcept { return ShapeView::Of(shapes[i]); }
+	size_t Bytes() const noexcept { return shapes.capacity() * sizeof(CF_ShapeWrapper) + aabbs.capacity() * sizeof(CF_Aabb); }
+
+	// 写入条目 i 时触及的缓存行
+	void TouchSet(size_t i, std::unordered_set<uintptr_t>& lines) const
+	{
+		touch(&shapes[i], sizeof(CF_ShapeWrapper), lines);
+		touch(&aabbs[i], sizeof(CF_Aabb), lines);
+	}
+	void TouchAabb(size_t i, std::unordered_set<uintptr_t>& lines) const { touch(&aabbs[i], sizeof(CF_Aabb), lines); }
+	// narrowphase 通过视图读取类型与 payload：包装的头部（类型）与所读字段所在的行
+	void TouchView(size_t i, std::unordered_set<uintptr_t>& lines) const { touch_view(View(i), &shapes[i].type, lines); }
+
+	static void touch(const void* p, size_t bytes, std::unordered_set<uintptr_t>& lines)
+	{
+		const uintptr_t a = reinterpret_cast<uintptr_t>(p);
+		for (uintptr_t l = a / kLine; l <= (a + bytes - 1) / kLine; ++l) lines.insert(l);
+	}
+	static void touch_view(const ShapeView& v, const void* type_field, std::unordered_set<uintptr_t>& lines)
+	{
+		touch(type_field, sizeof(CF_ShapeType), lines);
+		if (v.type == CF_SHAPE_TYPE_AABB) touch(v.data, sizeof(CF_Aabb), lines);
+		else if (v.type == CF_SHAPE_TYPE_POLY) {
+			const CF_Poly& p = v.poly();
+			touch(&p.verts[0], sizeof(CF_V2), lines);
+			touch(&p.norms[0], sizeof(CF_V2), lines);
+		}
+	}
+};
+
+// 当前布局；类型列与槽位列无法取得地址，以（分区, 列, 行号）作为键计入同一集合
+struct StoreShapes {
+	WorldShapeStore store;
+	uint64_t partition = 0; // 0 = 静态分区，1 = 运动分区
+
+	void Resize(size_t n) { store.Resize(n); }
+	void Set(size_t i, const CF_ShapeWrapper& s, const CF_Aabb& b) { store.Set(i, s, b); }
+	const std::vector<CF_Aabb>& Aabbs() const noexcept { return store.Aabbs(); }
+	const CF_Aabb& Aabb(size_t i) const noexcept { return store.Aabb(i); }
+	ShapeView View(size_t i) const noexcept { return store.View(i); }
+	size_t Bytes() const noexcept { return store.GetEstimatedMemoryUsageBytes(); }
+
+	// Set 总会读写类型列与槽位列，多边形另写入其池中的槽位
+	void TouchSet(size_t i, std::unordered_set<uintptr_t>& lines) const
+	{
+		touch_column(0, i * sizeof(uint8_t), lines);
+		touch_column(1, i * sizeof(uint32_t), lines);
+		LegacyShapes::touch(&store.Aabb(i), sizeof(CF_Aabb), lines);
+		const ShapeView v = store.View(i);
+		if (v.type == CF_SHAPE_TYPE_POLY) LegacyShapes::touch(v.data, sizeof(CF_Poly), lines);
+	}
+	void TouchAabb(size_t i, std::unordered_set<uintptr_t>& lines) const { LegacyShapes::touch(&store.Aabb(i), sizeof(CF_Aabb), lines); }
+	// View 读取类型列；非 AABB 形状还要读取槽位列与池中的数据
+	void TouchView(size_t i, std::unordered_set<uintptr_t>& lines) const
+	{
+		const ShapeView v = store.View(i);
+		touch_column(0, i * sizeof(uint8_t), lines);
+		if (v.type == CF_SHAPE_TYPE_AABB) {
+			LegacyShapes::touch(v.data, sizeof(CF_Aabb), lines);
+			return;
+		}
+		touch_column(1, i * sizeof(uint32_t), lines);
+		if (v.type == CF_SHAPE_TYPE_POLY) {
+			LegacyShapes::touch(&v.poly().verts[0], sizeof(CF_V2), lines);
+			LegacyShapes::touch(&v.poly().norms[0], sizeof(CF_V2), lines);
+		}
+	}
+
+	// 最高位标记推算的键，不会与用户态地址的行号冲突
+	void touch_column(uint64_t column, size_t offset, std::unordered_set<uintptr_t>& lines) const
+	{
+		lines.insert((uint64_t(1) << 63) | (partition << 62) | (column << 61) | (offset / kLine));
+	}
+};
+
+struct Partitions {
+	std::vector<uint8_t> static_flags, moving_flags;
+	std::vector<CollisionFilter> static_filters, moving_filters;
+};
+
+struct Result {
+	double write_us = 0.0, broad_us = 0.0, batch_us = 0.0, fetch_us = 0.0, step_us = 0.0;
+	size_t lines_write = 0, lines_read = 0;
+	size_t bytes = 0;
+	size_t pairs = 0, survivors = 0;
+	double checksum = 0.0;
+};
+
+double median(std::vector<double>& v)
+{
+	std::sort(v.begin(), v.end());
+	return v[v.size() / 2];
+}
+
+template <typename Store>
+Result run(const Scene& scene, const Partitions& parts, int frames)
+{
+	using clock = std::chrono::steady_clock;
+	const size_t ns = scene.statics.size(), nm = scene.moving[0].size();
+	std::vector<CF_Aabb> bounds[2];
+	for (int f = 0; f < 2; ++f) {
+		for (const CF_ShapeWrapper& s : scene.moving[f]) bounds[f].push_back(shape_bounds(s));
+	}
+
+	Store statics, moving;
+	if constexpr (std::is_same_v<Store, StoreShapes>) moving.partition = 1;
+	statics.Resize(ns);
+	for (size_t i = 0; i < ns; ++i) statics.Set(i, scene.statics[i], shape_bounds(scene.statics[i]));
+	moving.Resize(nm);
+	GridBroadphase broadphase;
+	broadphase.SetCellSize(64.0f);
+	broadphase.SetStatic(statics.Aabbs(), parts.static_flags, parts.static_filters);
+
+	std::vector<BroadphasePair> pairs;
+	AabbPairBatch batch;
+	std::vector<uint8_t> keep;
+	std::vector<double> t_write, t_broad, t_batch, t_fetch, t_step;
+	Result r;
+	// 第一帧用于预热（容器在此分配并在之后复用）
+	for (int f = 0; f <= frames; ++f) {
+		const std::vector<CF_ShapeWrapper>& src = scene.moving[f & 1];
+		const std::vector<CF_Aabb>& bnd = bounds[f & 1];
+		const auto t0 = clock::now();
+		for (size_t i = 0; i < nm; ++i) moving.Set(i, src[i], bnd[i]);
+		const auto t1 = clock::now();
+		pairs.clear();
+		broadphase.CollectPairs(moving.Aabbs(), parts.moving_flags, parts.moving_filters, pairs);
+		const auto t2 = clock::now();
+		batch.Clear();
+		batch.Reserve(pairs.size());
+		for (const BroadphasePair& p : pairs) {
+			const CF_Aabb& b = (p.b & BroadphasePair::STATIC_BIT) ? statics.Aabb(p.b & ~BroadphasePair::STATIC_BIT) : moving.Aabb(p.b);
+			batch.Push(moving.Aabb(p.a), b);
+		}
+		const size_t survivors = batch.TestOverlap(keep);
+		const auto t3 = clock::now();
+		double sum = 0.0;
+		for (size_t k = 0; k < pairs.size(); ++k) {
+			if (!keep[k]) continue;
+			const BroadphasePair& p = pairs[k];
+			const ShapeView b = (p.b & BroadphasePair::STATIC_BIT) ? statics.View(p.b & ~BroadphasePair::STATIC_BIT) : moving.View(p.b);
+			sum += payload_sum(moving.View(p.a)) + payload_sum(b);
+		}
+		const auto t4 = clock::now();
+		r.pairs = pairs.size();
+		r.survivors = survivors;
+		r.checksum = sum;
+		if (f == 0) continue;
+		auto us = [](clock::time_point a, clock::time_point b) { return std::chrono::duration<double, std::micro>(b - a).count(); };
+		t_write.push_back(us(t0, t1));
+		t_broad.push_back(us(t1, t2));
+		t_batch.push_back(us(t2, t3));
+		t_fetch.push_back(us(t3, t4));
+		t_step.push_back(us(t0, t4));
+	}
+	r.write_us = median(t_write);
+	r.broad_us = median(t_broad);
+	r.batch_us = median(t_batch);
+	r.fetch_us = median(t_fetch);
+	r.step_us = median(t_step);
+	r.bytes = statics.Bytes() + moving.Bytes();
+
+	// 触及的缓存行：写入阶段与之后三段读取阶段分别统计（broadphase 顺序读取整列 AABB）
+	std::unordered_set<uintptr_t> lines;
+	for (size_t i = 0; i < nm; ++i) moving.TouchSet(i, lines);
+	r.lines_write = lines.size();
+	lines.clear();
+	for (size_t i = 0; i < nm; ++i) moving.TouchAabb(i, lines);
+	for (size_t k = 0; k < pairs.size(); ++k) {
+		const BroadphasePair& p = pairs[k];
+		const bool is_static = (p.b & BroadphasePair::STATIC_BIT) != 0;
+		const size_t j = p.b & ~BroadphasePair::STATIC_BIT;
+		moving.TouchAabb(p.a, lines);
+		is_static ? statics.TouchAabb(j, lines) : moving.TouchAabb(j, lines);
+		if (!keep[k]) continue;
+		moving.TouchView(p.a, lines);
+		is_static ? statics.TouchView(j, lines) : moving.TouchView(j, lines);
+	}
+	r.lines_read = lines.size();
+	return r;
+}
+
+void print_row(size_t n, const char* name, const Result& r)
+{
+	std::printf("%8zu | %-15s | %7.1f | %7.1f | %7.1f | %7.1f | %8.1f | %9.1f | %9.1f | %8.2f\n", n, name,
+		r.write_us, r.broad_us, r.batch_us, r.fetch_us, r.step_us,
+		static_cast<double>(r.lines_write * kLine) / 1024.0, static_cast<double>(r.lines_read * kLine) / 1024.0,
+		static_cast<double>(r.bytes) / (1024.0 * 1024.0));
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	const int scale = argc > 1 ? std::max(1, std::atoi(argv[1])) : 1;
+	const size_t counts[] = { 1000, 10000, 50000 };
+	const int frames[] = { 400, 80, 20 };
+
+	std::printf("world shape storage: N static tiles + N moving bodies, 20%% triangles, median per Step (us), bytes touched per Step (KiB)\n");
+	std::printf("%8s | %-15s | %7s | %7s | %7s | %7s | %8s | %9s | %9s | %8s\n",
+		"bodies", "storage", "write", "broad", "batch", "fetch", "Step us", "write KiB", "read KiB", "MiB");
+	int status = 0;
+	for (size_t k = 0; k < 3; ++k) {
+		const Scene scene = make_scene(counts[k], 4321u + static_cast<uint32_t>(k));
+		Partitions parts;
+		parts.static_flags.assign(scene.statics.size(), BroadphaseFlag::ACTIVE);
+		parts.static_filters.assign(scene.statics.size(), CollisionFilter{});
+		parts.moving_flags.assign(scene.moving[0].size(), BroadphaseFlag::ACTIVE | BroadphaseFlag::QUERY_STATIC);
+		parts.moving_filters.assign(scene.moving[0].size(), CollisionFilter{});
+
+		const Result legacy = run<LegacyShapes>(scene, parts, frames[k] * scale);
+		const Result store = run<StoreShapes>(scene, parts, frames[k] * scale);
+		print_row(counts[k], "vector<Wrapper>", legacy);
+		print_row(counts[k], "WorldShapeStore", store);
+		std::printf("%8s | pairs %zu, overlapping %zu | Step x%.2f, bytes touched x%.2f, storage x%.2f\n", "",
+			store.pairs, store.survivors, legacy.step_us / store.step_us,
+			static_cast<double>(legacy.lines_write + legacy.lines_read) / static_cast<double>(store.lines_write + store.lines_read),
+			static_cast<double>(legacy.bytes) / static_cast<double>(store.bytes));
+		if (legacy.pairs != store.pairs || legacy.checksum != store.checksum) {
+			std::printf("MISMATCH: pair count or payload checksum differs\n");
+			status = 1;
+		}
+	}
+	return status;
+}
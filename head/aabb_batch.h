@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cute.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// AabbPairBatch 为一批待测试的 AABB 对（SoA 布局），面向使用者说明：
+// - Push 把一对 AABB 拆成 8 条 float 数组（A/B 的 min.x/min.y/max.x/max.y），TestOverlap 在这些数组上批量做重叠测试。
+// - 编译目标支持 AVX 时每次处理 8 对，支持 SSE2 时每次 4 对，其余平台（如未开启 SIMD 的 Emscripten）使用标量循环；
+//   三条路径结果一致，边界贴合视为重叠（与 broadphase 的 overlap_aabb 及 cf_collide 一致）。
+// - 容器容量在 Clear 之间复用，稳定后每帧无堆分配。
+// 语义契约：非线程安全；TestOverlap 为只读操作。
+class AabbPairBatch {
+public:
+	void Clear() noexcept;
+	void Reserve(size_t count);
+	void Push(const CF_Aabb& a, const CF_Aabb& b);
+	size_t Size() const noexcept { return ax0_.size(); }
+
+	// 对每一对写入 keep[i]（1 = 重叠，0 = 分离），返回重叠的对数
+	size_t TestOverlap(std::vector<uint8_t>& keep) const;
+
+	size_t GetEstimatedMemoryUsageBytes() const noexcept;
+
+private:
+	std::vector<float> ax0_, ay0_, ax1_, ay1_;
+	std::vector<float> bx0_, by0_, bx1_, by1_;
+};
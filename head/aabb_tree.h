@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cute.h>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// AabbTree 为动态包围盒层次树（broadphase 加速结构），面向使用者说明：
+// - 每个代理（proxy）是一片叶子，保存“胖”AABB（fat AABB = 实际 AABB 向外扩张 margin，并沿位移方向预测延伸）；
+//   只要对象的实际 AABB 仍在胖 AABB 内，MoveProxy 不修改树结构（O(1)）。
+// - 插入按周长代价启发式选择兄弟节点，沿途做 AVL 式旋转保持平衡，查询为 O(log n)。
+// - 节点存放在连续的 nodes_ 中，空闲节点以链表复用；遍历使用成员栈 stack_，稳定后查询无堆分配。
+// 语义契约：
+// - 代理 id 在 DestroyProxy 前保持不变；user_data 由调用方解释（PhysicsSystem 中为分区下标）。
+// - Query/RayCast 的回调签名见各函数说明，回调内不得修改本树。
+// - 非线程安全。
+class AabbTree {
+public:
+	static constexpr int32_t NULL_NODE = -1;
+
+	// 创建代理：aabb 为实际 AABB，margin 为胖 AABB 的扩张量
+	int32_t CreateProxy(const CF_Aabb& aabb, uint32_t user_data, float margin);
+	void DestroyProxy(int32_t proxy) noexcept;
+
+	// 更新代理：aabb 仍在胖 AABB 内时直接返回 false；否则以 margin 与 displacement 预测重建胖 AABB 并重新插入，返回 true
+	bool MoveProxy(int32_t proxy, const CF_Aabb& aabb, CF_V2 displacement, float margin);
+
+	const CF_Aabb& GetFatAabb(int32_t proxy) const noexcept { return nodes_[proxy].aabb; }
+	uint32_t GetUserData(int32_t proxy) const noexcept { return nodes_[proxy].user_data; }
+
+	// 遍历胖 AABB 与 box 相交的代理：callback(uint32_t user_data) 返回 false 时提前终止
+	template <typename F>
+	void Query(const CF_Aabb& box, F&& callback) const;
+
+	// 遍历胖 AABB 与线段 origin + dir * t（t ∈ [0, max_t]）相交的代理：
+	// callback(uint32_t user_data, float max_t) 返回新的 max_t（返回 0 终止；返回更小的值可裁剪后续遍历，用于最近命中）
+	template <typename F>
+	void RayCast(CF_V2 origin, CF_V2 dir, float max_t, F&& callback) const;
+
+	void Clear() noexcept;
+	size_t ProxyCount() const noexcept { return proxy_count_; }
+	int32_t Height() const noexcept { return root_ == NULL_NODE ? 0 : nodes_[root_].height; }
+	size_t GetEstimatedMemoryUsageBytes() const noexcept;
+
+private:
+	struct Node {
+		CF_Aabb aabb{};
+		int32_t parent = NULL_NODE; // 空闲节点时作为 free list 的 next
+		int32_t child1 = NULL_NODE;
+		int32_t child2 = NULL_NODE;
+		int32_t height = -1;        // 叶子为 0，空闲节点为 -1
+		uint32_t user_data = 0;
+
+		bool is_leaf() const noexcept { return child1 == NULL_NODE; }
+	};
+
+	int32_t allocate_node();
+	void free_node(int32_t id) noexcept;
+	void insert_leaf(int32_t leaf) noexcept;
+	void remove_leaf(int32_t leaf) noexcept;
+	int32_t balance(int32_t a) noexcept;
+
+	static bool overlap(const CF_Aabb& a, const CF_Aabb& b) noexcept
+	{
+		return a.min.x <= b.max.x && b.min.x <= a.max.x && a.min.y <= b.max.y && b.min.y <= a.max.y;
+	}
+	static bool contains(const CF_Aabb& outer, const CF_Aabb& inner) noexcept
+	{
+		return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && inner.max.x <= outer.max.x && inner.max.y <= outer.max.y;
+	}
+	static CF_Aabb combine(const CF_Aabb& a, const CF_Aabb& b) noexcept
+	{
+		CF_Aabb c;
+		c.min = cf_v2(a.min.x < b.min.x ? a.min.x : b.min.x, a.min.y < b.min.y ? a.min.y : b.min.y);
+		c.max = cf_v2(a.max.x > b.max.x ? a.max.x : b.max.x, a.max.y > b.max.y ? a.max.y : b.max.y);
+		return c;
+	}
+	static float perimeter(const CF_Aabb& a) noexcept
+	{
+		return 2.0f * ((a.max.x - a.min.x) + (a.max.y - a.min.y));
+	}
+	// 线段与 AABB 的 slab 测试（dir 分量为 0 时退化为区间包含判断）
+	static bool segment_overlaps(const CF_Aabb& box, CF_V2 origin, CF_V2 dir, float max_t) noexcept;
+
+	std::vector<Node> nodes_;
+	int32_t root_ = NULL_NODE;
+	int32_t free_list_ = NULL_NODE;
+	size_t proxy_count_ = 0;
+	mutable std::vector<int32_t> stack_; // Query/RayCast 的遍历栈（复用容量）
+};
+
+template <typename F>
+void AabbTree::Query(const CF_Aabb& box, F&& callback) const
+{
+	if (root_ == NULL_NODE) return;
+	stack_.clear();
+	stack_.push_back(root_);
+	while (!stack_.empty()) {
+		const Node& n = nodes_[stack_.back()];
+		stack_.pop_back();
+		if (!overlap(n.aabb, box)) continue;
+		if (n.is_leaf()) {
+			if (!callback(n.user_data)) return;
+		}
+		else {
+			stack_.push_back(n.child1);
+			stack_.push_back(n.child2);
+		}
+	}
+}
+
+template <typename F>
+void AabbTree::RayCast(CF_V2 origin, CF_V2 dir, float max_t, F&& callback) const
+{
+	if (root_ == NULL_NODE || max_t <= 0.0f) return;
+	stack_.clear();
+	stack_.push_back(root_);
+	while (!stack_.empty()) {
+		const Node& n = nodes_[stack_.back()];
+		stack_.pop_back();
+		if (!segment_overlaps(n.aabb, origin, dir, max_t)) continue;
+		if (n.is_leaf()) {
+			max_t = callback(n.user_data, max_t);
+			if (max_t <= 0.0f) return;
+		}
+		else {
+			stack_.push_back(n.child1);
+			stack_.push_back(n.child2);
+		}
+	}
+}
@@ -7,7 +7,6 @@
 #include <vector> 
 #include <iostream> 
 #include <cmath> 
-#include <unordered_set> 
 
 #include "obj_manager.h"
 #include "debug_config.h"
@@ -81,7 +80,6 @@ public:
         // 强制把 world-shape 与当前物理状态同步，避免初始碰撞形状基于未同步的缓存数据
         force_update_world_shape();
 
-        tags.reserve(5);
         m_sprite = cf_sprite_defaults();
     }
 
@@ -103,7 +101,8 @@ public:
      {
  		m_collide_manifolds.clear();
          m_collide_manifolds.reserve(4);
- 		StartFrame();
+ 		// 未重写 StartFrame 的类型（由 ObjManager 在创建时检测）跳过这次虚调用
+ 		if (m_update_hooks & UpdateHooks::START_FRAME) StartFrame();
  		ApplyForce();
  		ApplyVelocity();
      }
@@ -130,14 +129,25 @@ public:
      * 场景主循环中“退出帧处理”时调用。
      * 功能：
      * - 调用 EndFrame（供派生类扩展）
-	 * - 记录当前帧结束时的位置到 m_prev_position，以便下一帧使用。
      */
     APPLIANCE void FrameExitApply() noexcept
     {
-        EndFrame();
-        m_prev_position = get_position();
+        if (m_update_hooks & UpdateHooks::END_FRAME) EndFrame();
 	}
 
+    /*
+     * StepBeginApply
+     * 每个逻辑步开始时（main_thread_on_update 之前）由 ObjManager::BeginStep 调用。
+     * 功能：
+     * - 记录上一步结束时的位置到 m_prev_position：ActSeq 等脚本在 main_thread_on_update 中移动对象，
+     *   必须在此之前记录，渲染才能在 m_prev_position 与当前位置之间插值
+     */
+    APPLIANCE void StepBeginApply() noexcept
+    {
+        m_prev_position = get_position();
+        m_has_stepped = true;
+    }
+
 	// 供派生类在帧首执行初始化/状态准备，默认为空
 	virtual void StartFrame() {}
 	// 供派生类在帧尾执行清理/状态同步，默认为空
@@ -252,6 +262,23 @@ public:
     // 新增：设置精灵更新频率（向后兼容）
     void SpriteSetUpdateFreq(int update_freq) noexcept;
 
+    /*
+     * 动画片段（clip）API：
+     * - 在 Start() 中用 SpriteAddClip 预加载一组命名片段（每个片段一张竖排雪碧图 + 帧数 + 更新频率），返回片段索引；
+     *   预加载时通过 SpriteCache 持有引用，PNG 仅在首次使用时解码。
+     * - 之后用 SpritePlayClip(index) 按索引切换：只替换纹理句柄与帧参数，不做文件 I/O、不分配内存、
+     *   也不会从 DrawingSequence 注销/重新注册；切换到当前片段时为空操作。
+     * - 切换片段不会改动碰撞体（等价于 SpriteSetSource(..., set_shape_aabb = false)），pivot 按新片段尺寸重新换算渲染偏移。
+     * - 调用 SpriteSetSource 会退出片段模式（当前片段索引重置为 -1），已预加载的片段仍保留，可再次 SpritePlayClip。
+     */
+    int SpriteAddClip(const std::string& name, const std::string& path, int vertical_frame_count, int update_freq) noexcept;
+    // 按名称查找片段索引，未找到返回 -1（字符串比较，建议只在 Start() 中调用并缓存结果）
+    int SpriteFindClip(const std::string& name) const noexcept;
+    // 切换到指定片段，索引无效时返回 false
+    bool SpritePlayClip(int index) noexcept;
+    // 当前播放的片段索引（未使用片段模式时为 -1）
+    int SpriteGetClip() const noexcept { return m_sprite_clip_index; }
+
     // 碰撞体旋转/应用 pivot 的策略开关：
     // - IsColliderRotate(true/false)：若为 true，同步 sprite 的旋转到物理碰撞体（常用于角色随朝向旋转时碰撞体也跟随）
     // - IsColliderApplyPivot(true/false)：若为 true，pivot 改变会影响碰撞体的局部位置
@@ -273,6 +300,16 @@ public:
     // 物理/碰撞状态访问（只读）
     const CF_V2& GetPosition() const noexcept { return get_position(); }
     const CF_V2& GetPrevPosition() const noexcept { return m_prev_position; }
+    // 渲染插值位置：alpha 为累加器中未消耗时间占一个逻辑步的比例，在 m_prev_position 与当前位置之间线性插值。
+    // 尚未经历过逻辑步的对象、或单步位移超过 RENDER_SNAP_DISTANCE（重生/传送）时直接返回当前位置，避免拖影。
+    CF_V2 GetRenderPosition(float alpha) const noexcept
+    {
+        const CF_V2& cur = get_position();
+        if (!m_has_stepped) return cur;
+        const CF_V2 d = cur - m_prev_position;
+        if (d.x * d.x + d.y * d.y > RENDER_SNAP_DISTANCE * RENDER_SNAP_DISTANCE) return cur;
+        return CF_V2{ m_prev_position.x + d.x * alpha, m_prev_position.y + d.y * alpha };
+    }
     const CF_V2& GetVelocity() const noexcept { return get_velocity(); }
     const CF_V2& GetForce() const noexcept { return get_force(); }
     const CF_ShapeWrapper& GetShape() const noexcept { return get_shape(); }
@@ -296,6 +333,36 @@ public:
     // 碰撞类型设置（影响如何参与碰撞分组/判定）
     void SetColliderType(ColliderType t) noexcept { set_collider_type(t); }
 
+    // 运动分类设置（STATIC / KINEMATIC / DYNAMIC，默认 DYNAMIC），决定对象在 PhysicsSystem 中的分区与碰撞测试范围
+    // - 建议在 Start() 中设置；运行时修改会在下一次物理步进开头迁移分区
+    void SetBodyKind(BodyKind k) noexcept { set_body_kind(k); }
+    BodyKind GetBodyKind() const noexcept { return get_body_kind(); }
+
+    // 订阅与 KINEMATIC 的接触事件：KINEMATIC-STATIC / KINEMATIC-KINEMATIC 对默认不测试，任一方开启后照常派发 Enter/Stay/Exit
+    void SetKinematicContacts(bool enable) noexcept { set_kinematic_contacts(enable); }
+    bool GetKinematicContacts() const noexcept { return get_kinematic_contacts(); }
+
+    // 碰撞层设置（category 为所属层，mask 为愿意碰撞的层，取值见 CollisionLayer）
+    // - 双方互相接受才会产生碰撞事件；被拒绝的对在 broadphase 内丢弃，不进入 narrowphase
+    void SetCollisionLayer(uint32_t category, uint32_t mask = CollisionLayer::ALL) noexcept { set_collision_layer(category, mask); }
+    uint32_t GetCollisionCategory() const noexcept { return get_collision_category(); }
+    uint32_t GetCollisionMask() const noexcept { return get_collision_mask(); }
+
+    // 休眠控制：静止一段时间的运动体会休眠（跳过 narrowphase，已有接触继续收到 Stay），移动或获得速度时自动唤醒
+    void SetAllowSleep(bool allow) noexcept { set_allow_sleep(allow); }
+    bool IsSleeping() const noexcept { return is_sleeping(); }
+
+    // 连续碰撞：适合子弹、血迹等每帧位移接近或超过地形厚度的对象；开启后碰到 SOLID 时位置停在最早接触处，
+    // ExclusionWithSolid 只需退出残余的接触皮厚度，不再逐段回退与二分
+    void SetContinuousCollision(bool enable) noexcept { set_continuous(enable); }
+    bool IsContinuousCollision() const noexcept { return is_continuous(); }
+
+    // 激活区域：PhysicsSystem 设置了激活区域时，区域外的对象暂停模拟与 Update；
+    // 离屏后仍需运行的对象（玩家、按寿命自毁的子弹等）设为 always-active
+    void SetAlwaysActive(bool enable) noexcept { set_always_active(enable); }
+    bool IsAlwaysActive() const noexcept { return is_always_active(); }
+    bool IsRegionActive() const noexcept { return is_region_active(); }
+
     /*
      * SetCentered*
      * 推荐使用的碰撞体构造器：在对象局部坐标系以中心为原点创建形状。
@@ -414,11 +481,30 @@ public:
     // - AddTag：添加标记（重复添加无效）
     // - HasTag：判断是否存在标记
     // - RemoveTag：移除标记
-    void AddTag(const std::string& tag) noexcept { tags.insert(tag); }
+    // 标签以 TagRegistry 编号的位掩码保存；TagId 版本只做位运算，字符串版本需一次哈希查找（热路径请缓存 TagId）。
+    // 已注册对象的增删会同步到 ObjManager 的标签成员表，供 FindTokensByTag 按匹配数量查询。
+    void AddTag(const std::string& tag) noexcept { AddTag(TagRegistry::Instance().Intern(tag)); }
+    void AddTag(TagId tag) noexcept
+    {
+        const TagRegistry::Mask bit = TagRegistry::Bit(tag);
+        if (!bit || (m_tag_mask & bit)) return;
+        m_tag_mask |= bit;
+        if (m_obj_token.isRegitsered) ObjManager::Instance().LinkTags(m_obj_token.index, bit);
+    }
 
-    bool HasTag(const std::string& tag) const noexcept { return tags.find(tag) != tags.end(); }
+    bool HasTag(const std::string& tag) const noexcept { return HasTag(TagRegistry::Instance().Find(tag)); }
+    bool HasTag(TagId tag) const noexcept { return (m_tag_mask & TagRegistry::Bit(tag)) != 0; }
+
+    void RemoveTag(const std::string& tag) noexcept { RemoveTag(TagRegistry::Instance().Find(tag)); }
+    void RemoveTag(TagId tag) noexcept
+    {
+        const TagRegistry::Mask bit = TagRegistry::Bit(tag);
+        if (!(m_tag_mask & bit)) return;
+        m_tag_mask &= ~bit;
+        if (m_obj_token.isRegitsered) ObjManager::Instance().UnlinkTags(m_obj_token.index, bit);
+    }
 
-    void RemoveTag(const std::string& tag) noexcept { tags.erase(tag); }
+    TagRegistry::Mask GetTagMask() const noexcept { return m_tag_mask; }
 
     // 对象销毁钩子：在对象被销毁前由管理器调用，派生类可重载以释放资源
     virtual void OnDestroy() noexcept {}
@@ -488,7 +574,20 @@ private:
 	int m_sprite_update_freq = 1; // 每多少帧递增帧索引
     int m_sprite_last_update_frame = 0; // 上一次实际切换帧的全局帧计数
 
-    CF_V2 m_prev_position = CF_V2{ 0.0f, 0.0f };
+    // 预加载的动画片段：sprite 为 SpriteCache 中模板的拷贝，对象持有其缓存引用直到析构
+    struct SpriteClip {
+        std::string name;
+        std::string path;
+        CF_Sprite sprite{};
+        int vertical_frame_count = 1;
+        int update_freq = 1;
+    };
+    std::vector<SpriteClip> m_sprite_clips;
+    int m_sprite_clip_index = -1; // 当前播放的片段索引，-1 表示使用 SpriteSetSource 设置的普通精灵
+
+    CF_V2 m_prev_position = CF_V2{ 0.0f, 0.0f }; // 上一逻辑步结束时的位置（StepBeginApply 记录，渲染插值起点）
+    bool m_has_stepped = false;
+    static constexpr float RENDER_SNAP_DISTANCE = 64.0f; // 单步位移超过该值（像素）视为瞬移，不做插值
 	CF_V2 m_pivot = CF_V2{ 0.0f, 0.0f };
 
     bool m_isColliderRotate = true;
@@ -498,12 +597,18 @@ private:
      CF_Manifold ExclusionWithSolid(const ObjManager::ObjToken& oth, const CF_Manifold& m) noexcept;
 	// 二分查找接触点位置，在排斥过程中用于逼近刚好接触的坐标
      void FindContactPos(CF_V2 current, CF_V2 offset, const BaseObject& other, CF_Manifold& res);
+	// 解析排斥：穿透由自身运动造成时沿 -vel 回退到 slab 法求得的接触处，否则沿 manifold 法线按深度推出
+	// （不适用时返回 false，由调用方退回逐段回退与二分逼近）
+     bool ResolveSolidAnalytic(const BaseObject& other, CF_Manifold& res) noexcept;
+	// 解析排斥后保留的残余穿透（像素），使对象停在仍被判定为接触的一侧
+     static constexpr float EXCLUSION_SLOP = 1e-3f;
  	// 每帧累积的碰撞信息（仅用于调试/后续逻辑），在 FrameEnterApply 开头清空
      std::vector<CF_Manifold> m_collide_manifolds;
 
-	std::unordered_set<std::string> tags;
+	TagRegistry::Mask m_tag_mask = 0; // 每个 TagId 占一位
 
     ObjManager::ObjToken m_obj_token = ObjManager::ObjToken::Invalid();
+    uint8_t m_update_hooks = UpdateHooks::ALL; // 该对象实际重写的逐帧钩子（ObjManager::Create 时写入）
 
     void SetObjToken(const ObjManager::ObjToken& t) noexcept { m_obj_token = t; }
 
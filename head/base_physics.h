@@ -2,10 +2,15 @@
 #include <cute.h>
 #include <vector>
 #include <unordered_map>
+#include <memory>
+#include <string>
 #include <cstdint>
 
 #include "obj_manager.h"
 #include "v2math.h"
+#include "broadphase.h"
+#include "worker_pool.h"
+#include "aabb_batch.h"
 
 // CF_ShapeWrapper 封装了不同类型的碰撞形状（AABB, Circle, Capsule, Poly），
 // 并提供静态工厂函数便于创建对应的包装类型。
@@ -30,15 +35,107 @@ struct CF_ShapeWrapper
 	static CF_ShapeWrapper FromPoly(const CF_Poly& p) { CF_ShapeWrapper s{}; s.type = CF_SHAPE_TYPE_POLY; s.u.poly = p; return s; }
 };
 
+// ShapeView 为只读的形状视图：类型 + 指向 CF_Aabb / CF_Circle / CF_Capsule / CF_Poly 的指针，
+// 可直接传给 cf_collide / cf_cast_ray，避免为每次测试拷贝整个 CF_ShapeWrapper。
+// 视图不拥有数据，所指向的存储（CF_ShapeWrapper 或 WorldShapeStore）在使用期间不得被修改。
+struct ShapeView {
+	CF_ShapeType type = CF_SHAPE_TYPE_NONE;
+	const void* data = nullptr;
+
+	static ShapeView Of(const CF_ShapeWrapper& s) noexcept { return ShapeView{ s.type, &s.u }; }
+	const CF_Aabb& aabb() const noexcept { return *static_cast<const CF_Aabb*>(data); }
+	const CF_Circle& circle() const noexcept { return *static_cast<const CF_Circle*>(data); }
+	const CF_Capsule& capsule() const noexcept { return *static_cast<const CF_Capsule*>(data); }
+	const CF_Poly& poly() const noexcept { return *static_cast<const CF_Poly*>(data); }
+};
+
+// WorldShapeStore 为 PhysicsSystem 的 world-space 形状缓存（SoA 布局），面向使用者说明：
+// - 每个条目拆成三列：world AABB（broadphase 与批量重叠测试只读这一列）、形状类型、在对应类型 payload 池中的槽位；
+//   圆 / 胶囊 / 多边形各自一个紧凑池，AABB 形状的 payload 就是 AABB 列本身，不再额外占用空间。
+// - 相比每个条目一个按 8 顶点多边形大小的 CF_ShapeWrapper，瓦片地图中以 AABB 为主的条目只占 AABB + 类型 + 槽位。
+// - 池槽位在类型不变时原地复用，类型变化或条目被截断时归还空闲链表，稳定后每帧无堆分配。
+// 语义契约：View() 返回的视图在下一次 Set/Copy/Resize 之前有效；非线程安全，构建完成后的读取为只读操作。
+class WorldShapeStore {
+public:
+	size_t Size() const noexcept { return aabbs_.size(); }
+	// 调整条目数；新增条目的类型为 NONE，截断的条目归还其 payload 槽位
+	void Resize(size_t count);
+	// 写入条目 i 的 world shape 与其 AABB（AABB 形状时两者相同）
+	void Set(size_t i, const CF_ShapeWrapper& shape, const CF_Aabb& bounds);
+	// 把条目 src 复制到 dst（用于尾部条目填补被移除的位置）
+	void Copy(size_t dst, size_t src);
+
+	const std::vector<CF_Aabb>& Aabbs() const noexcept { return aabbs_; }
+	const CF_Aabb& Aabb(size_t i) const noexcept { return aabbs_[i]; }
+	ShapeView View(size_t i) const noexcept;
+
+	size_t GetEstimatedMemoryUsageBytes() const noexcept;
+
+private:
+	uint32_t alloc_slot(CF_ShapeType type);
+	void free_slot(CF_ShapeType type, uint32_t slot) noexcept;
+	// 保证条目 i 的类型为 type 并持有对应池的槽位
+	void retype(size_t i, CF_ShapeType type);
+
+	std::vector<CF_Aabb> aabbs_;
+	std::vector<uint8_t> types_;   // CF_ShapeType
+	std::vector<uint32_t> slots_;  // payload 池下标（AABB / NONE 不使用）
+	std::vector<CF_Circle> circles_;
+	std::vector<CF_Capsule> capsules_;
+	std::vector<CF_Poly> polys_;
+	std::vector<uint32_t> free_circles_;
+	std::vector<uint32_t> free_capsules_;
+	std::vector<uint32_t> free_polys_;
+};
+
 enum class ColliderType {
 	VOID, // 不参与碰撞（例如触发器被关闭或仅用于标记）
 	LIQUID, // 液体样碰撞（可定制行为：可穿透或带有流体交互）
 	SOLID // 实体碰撞（常规碰撞：阻挡、反弹等）
 };
 
+// 刚体运动分类：决定对象在 PhysicsSystem 中所处的分区以及与哪些对象做碰撞测试
+// - STATIC：几乎不动的场景体（方块、固定刺等）。注册时一次性插入持久的静态 broadphase，仅在移动/形状变化时重新插入；
+//   静态体之间不做碰撞测试。
+// - KINEMATIC：由脚本驱动移动（ActSeq 移动的刺/方块等），每帧参与 broadphase，默认只与 DYNAMIC 做碰撞测试；
+//   KINEMATIC-STATIC / KINEMATIC-KINEMATIC 对只有在任一方开启 set_kinematic_contacts(true) 时才会测试并派发事件。
+// - DYNAMIC：受速度/力驱动并需要完整碰撞响应的对象（玩家、子弹、血迹等），与所有分类做碰撞测试（默认值）。
+enum class BodyKind {
+	STATIC,
+	KINEMATIC,
+	DYNAMIC
+};
+
+// 碰撞层（BasePhysics::set_collision_layer 的 category / mask 取值）：
+// - 每个对象属于一个或多个层（category），并声明愿意与哪些层碰撞（mask）；双方互相接受才会进入 narrowphase
+// - 默认 category = DEFAULT、mask = ALL，未设置碰撞层的对象与所有对象碰撞，与旧行为一致
+// - 规则对称：例如子弹 mask 不含 HAZARD 时，子弹与刺之间的对在 broadphase 内即被丢弃，无需刺一侧配合
+namespace CollisionLayer {
+	inline constexpr uint32_t DEFAULT = 1u << 0;    // 未显式设置碰撞层的对象（目前刺、樱桃等危险物均在此层）
+	inline constexpr uint32_t PLAYER = 1u << 1;
+	inline constexpr uint32_t TERRAIN = 1u << 2;    // 方块等地形
+	inline constexpr uint32_t HAZARD = 1u << 3;     // 预留给需要与 DEFAULT 区分的危险物
+	inline constexpr uint32_t PROJECTILE = 1u << 4; // 子弹
+	inline constexpr uint32_t TRIGGER = 1u << 5;    // 存档点等触发器
+	inline constexpr uint32_t DECOR = 1u << 6;      // 血迹等装饰性物理对象
+	inline constexpr uint32_t ALL = 0xFFFFFFFFu;
+}
+
 // 前置声明：BasePhysics 提供给上层对象一个统一的物理属性/形状接口
 class BasePhysics;
 
+// PhysicsSystem 空间查询的过滤条件（默认不过滤）：
+// - tag 不为 TagRegistry::INVALID 时只返回 BaseObject::HasTag(tag) 的对象（例如 TagRegistry::Instance().Intern("player")）
+// - collider_mask 为 PhysicsSystem::ColliderMaskOf(ColliderType) 的按位或；VOID 条目不进入 broadphase，永远不会被返回
+// - ignore 为需要排除的对象（通常是查询者自身）
+// - layer_mask 为 CollisionLayer 的按位或，只返回 category 与之相交的对象
+struct PhysicsQueryFilter {
+	TagId tag = TagRegistry::INVALID;
+	uint8_t collider_mask = 0xFF;
+	ObjManager::ObjToken ignore = ObjManager::ObjToken::Invalid();
+	uint32_t layer_mask = CollisionLayer::ALL;
+};
+
 // PhysicsSystem 提供面向使用者的物理子系统入口：
 // - 注册/反注册 BasePhysics 实例（通过 ObjToken 关联对象生命周期）
 // - Step() 在每帧执行 broadphase -> narrowphase -> 事件合并 -> Enter/Stay/Exit 回调阶段
@@ -65,12 +162,106 @@ public:
 	void Register(const ObjManager::ObjToken& token, BasePhysics* phys) noexcept;
 
 	// 从系统中移除指定 token 的物理条目（通常在对象销毁前调用）
-	void Unregister(const ObjManager::ObjToken& token) noexcept;
+	// - 只遍历该物体自身的活跃接触链表，把相关碰撞对标记为已移除，并向仍然存活的对方立即派发 OnCollisionExit
+	// - notify_exit 为 false 时只清理不派发（DestroyAll 等整体销毁场景，对方也即将被销毁）
+	void Unregister(const ObjManager::ObjToken& token, bool notify_exit = true) noexcept;
 
-	// 每帧推进物理系统（cell_size 可调整 broadphase 网格规模，默认 64.0f）
-	// - Step 包含 broadphase 网格划分、narrowphase 碰撞测试、合并多个 contact 为单对事件、以及生成 Enter/Stay/Exit 回调
+	// 整体清空全部条目、碰撞对与缓存（房间卸载时由 ObjManager::DestroyAll 调用，代替逐个 Unregister）
+	// - 不派发 Exit；各容器保留容量供下一个房间复用，静态分区在下一次 Step 重新提交（为空）
+	void Clear() noexcept;
+
+	// 每帧推进物理系统（cell_size 可调整 GRID 后端的网格规模，默认 64.0f；其它后端忽略）
+	// - Step 包含 broadphase 候选对收集、narrowphase 碰撞测试、合并多个 contact 为单对事件、以及生成 Enter/Stay/Exit 回调
+	// - 静态分区仅在有静态体移动/变更时重新提交给 broadphase，每帧开销只与运动体数量相关
 	void Step(float cell_size = 64.0f) noexcept;
 
+	// 切换 broadphase 后端（可在任意两帧之间调用，例如在房间 RoomLoad 中按场景布局选择）
+	// - 新后端在下一次 Step 开头接收完整的静态分区，之后与原后端一样增量维护
+	// - 对事件语义无影响：不同后端只改变候选对的产生方式，碰撞结果一致
+	void SetBroadphaseMode(BroadphaseMode mode);
+	BroadphaseMode GetBroadphaseMode() const noexcept { return broadphase_->Mode(); }
+
+	// 设置 narrowphase 使用的工作线程数（不含主线程，默认 0 即串行）
+	// - 候选对较多时把 shapes_collide_world 分给工作线程，结果按候选对顺序合并，事件与回调顺序与串行完全一致
+	// - 回调分发（Enter/Stay/Exit）始终在调用 Step 的线程上执行
+	void SetWorkerThreads(size_t threads) { workers_.Resize(threads); }
+	size_t GetWorkerThreads() const noexcept { return workers_.ThreadCount(); }
+
+	// 激活区域（默认不设置，即全部对象都参与模拟）：
+	// - 设置后，world AABB 与区域不相交且未标记 always_active 的对象被视为未激活：
+	//   不进入 broadphase（因而也不参与 narrowphase 与空间查询），ObjManager::UpdateAll 跳过其 FrameEnterApply/Update/FrameExitApply
+	// - 与区域外对象之间已有的接触在下一次 Step 产生 Exit；对象重新进入区域时被唤醒并按当前位置重新配对
+	// - 区域通常取镜头视野外扩一圈，需要在离屏时继续运行的对象（玩家、有寿命的子弹等）应设置 always_active
+	void SetActivationRegion(const CF_Aabb& region) noexcept { activation_region_ = region; has_activation_region_ = true; }
+	void ClearActivationRegion() noexcept { has_activation_region_ = false; }
+	bool HasActivationRegion() const noexcept { return has_activation_region_; }
+	const CF_Aabb& GetActivationRegion() const noexcept { return activation_region_; }
+	// 按当前激活区域刷新对象的激活状态并返回结果；ObjManager::UpdateAll 在帧首对每个对象调用一次，Step 沿用该结果
+	bool RefreshActivation(BasePhysics& p) noexcept;
+
+	// 由 BasePhysics 在静态体移动/形状变化或 BodyKind 改变时调用，把该条目排入下一次 Step 开头的分区刷新队列
+	void QueuePartitionRefresh(uint64_t key) noexcept;
+
+	using QueryFilter = PhysicsQueryFilter;
+	static constexpr uint8_t ColliderMaskOf(ColliderType t) noexcept { return static_cast<uint8_t>(1u << static_cast<unsigned>(t)); }
+
+	// 空间查询（基于最近一次 Step 提交给 broadphase 的 AABB 与 world shape），结果追加到 out
+	// - 先由当前 broadphase 取得候选条目（GRID 查格子 / SAP 扫描排序序列 / AABB_TREE 遍历树），再对 world shape 做精确测试
+	// - 同一对象只出现一次；out 由调用方持有并复用，内部候选缓冲同样复用容量，稳定后无堆分配
+	// - 典型用法：在 Update() 中检测触发区域，代替逐对象比较坐标
+	void QueryPoint(CF_V2 point, std::vector<ObjManager::ObjToken>& out, const QueryFilter& filter = {}) const;
+	void QueryAabb(const CF_Aabb& box, std::vector<ObjManager::ObjToken>& out, const QueryFilter& filter = {}) const;
+	void QueryCircle(CF_V2 center, float radius, std::vector<ObjManager::ObjToken>& out, const QueryFilter& filter = {}) const;
+	// shape 必须是 world-space 形状
+	void QueryShape(const CF_ShapeWrapper& shape, std::vector<ObjManager::ObjToken>& out, const QueryFilter& filter = {}) const;
+
+	struct RaycastHit {
+		ObjManager::ObjToken token;
+		float distance = 0.0f; // 沿射线方向到命中点的距离
+		CF_V2 point{};         // world-space 命中点
+		CF_V2 normal{};        // 命中表面的法线
+	};
+	// 从 origin 沿 dir（无需归一化）发射长度为 max_distance 的射线：
+	// - Raycast 返回最近的命中；无命中返回 false
+	// - RaycastAll 把所有命中按距离升序追加到 out_hits
+	bool Raycast(CF_V2 origin, CF_V2 dir, float max_distance, RaycastHit& out_hit, const QueryFilter& filter = {}) const;
+	void RaycastAll(CF_V2 origin, CF_V2 dir, float max_distance, std::vector<RaycastHit>& out_hits, const QueryFilter& filter = {}) const;
+
+	// 对两个 world-space 形状执行与 Step 相同的 narrowphase（分派表中的专用内核 + manifold 规范化），
+	// 不涉及任何注册条目；供一次性检测、测试与基准使用。out 为 nullptr 时只返回是否相交
+	static bool CollideShapes(const ShapeView& a, const ShapeView& b, CF_Manifold* out = nullptr) noexcept;
+	// 连续碰撞使用的 slab 法扫掠：a_end 为位移结束时的 AABB，沿 motion 扫向静止的 b，返回 [0,1] 内的最早接触时间，
+	// 起点已重叠或本帧不会接触时返回 -1；out_axis 写入接触面法线所在的轴（0 为 x，1 为 y）
+	static float SweepAabbToi(const CF_Aabb& a_end, CF_V2 motion, const CF_Aabb& b, int* out_axis = nullptr) noexcept;
+	// world-space 形状的轴对齐包围盒（与 broadphase 使用的包围盒一致）
+	static CF_Aabb ShapeAabb(const CF_ShapeWrapper& shape) noexcept;
+
+	// 最近一次 Step 的 broadphase/narrowphase 统计（用于性能观察、cell_size 调优与后端选择）
+	struct StepStats {
+		size_t moving_bodies = 0;      // 运动分区条目数
+		size_t static_bodies = 0;      // 静态分区条目数
+		size_t broadphase_pairs = 0;   // broadphase 本帧产生的候选对数（每对一次）
+		size_t duplicate_pairs_skipped = 0; // GRID：因共享多个格子而在 broadphase 内跳过的重复对数（即节省的 narrowphase 次数）
+		size_t aabb_rejected_pairs = 0; // GRID：只共享格子、AABB 并不重叠而被批量重叠测试剔除的候选对数
+		size_t moving_cells = 0;       // GRID：运动网格本帧占用的格子数
+		size_t moving_cell_refs = 0;   // GRID：运动网格本帧的 (格子, 条目) 引用数
+		size_t static_cells = 0;       // GRID：静态网格占用的格子数
+		size_t static_cell_refs = 0;   // GRID：静态网格的 (格子, 条目) 引用数
+		size_t sort_swaps = 0;         // SWEEP_AND_PRUNE：本帧插入排序的交换次数
+		size_t tree_updates = 0;       // AABB_TREE：本帧真正修改了树结构的运动代理数（在胖 AABB 内移动不计入）
+		size_t static_rebuilds = 0;    // 本帧静态分区是否被重新提交给 broadphase（0/1）
+		size_t narrowphase_tests = 0;  // 本帧调用 shapes_collide_world 的次数
+		size_t cached_pairs = 0;       // 双方 world shape 版本未变、直接复用上一次结果的候选对数
+		size_t persisted_contacts = 0; // 双方均静止（休眠/静态）而沿用的接触数（不经过 broadphase 与 narrowphase）
+		size_t sleeping_bodies = 0;    // 本帧处于休眠的运动条目数
+		size_t inactive_bodies = 0;    // 本帧位于激活区域外、被跳过的运动条目数
+		size_t continuous_bodies = 0;  // 本帧参与扫掠检测（CCD）的运动条目数
+		size_t continuous_clamped = 0; // 本帧因扫掠命中 SOLID 而被拉回最早接触处的条目数
+		size_t raw_events = 0;         // 本帧产生的碰撞事件数（含沿用的接触）
+	};
+	const StepStats& GetStats() const noexcept { return stats_; }
+	size_t GetEstimatedMemoryUsageBytes() const noexcept;
+
 private:
 	PhysicsSystem() noexcept = default;
 	~PhysicsSystem() noexcept = default;
@@ -78,9 +269,6 @@ private:
 	struct Entry {
 		ObjManager::ObjToken token;
 		BasePhysics* physics = nullptr;
-		int32_t grid_x = 0;
-		int32_t grid_y = 0;
-		bool dirty = true;
 	};
 
 	// 将 (index,generation) 编码为 uint64_t，以便与 ObjManager 的 token 匹配
@@ -89,33 +277,135 @@ private:
 		return (static_cast<uint64_t>(t.index) << 32) | static_cast<uint64_t>(t.generation);
 	}
 
-	// 将 grid 坐标编码为 uint64_t 用作 unordered_map 的键
-	static uint64_t grid_key(int32_t x, int32_t y) noexcept
-	{
-		return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint64_t>(static_cast<uint32_t>(y));
-	}
+	// 一对条目的精确标识：两个 token key 按升序存放（lo <= hi），不压缩为单个哈希值，不同的对永远不会相等
+	struct PairKey {
+		uint64_t lo = 0;
+		uint64_t hi = 0;
+		static PairKey Make(uint64_t a, uint64_t b) noexcept { return a <= b ? PairKey{ a, b } : PairKey{ b, a }; }
+		bool operator==(const PairKey& o) const noexcept { return lo == o.lo && hi == o.hi; }
+		bool operator<(const PairKey& o) const noexcept { return lo != o.lo ? lo < o.lo : hi < o.hi; }
+	};
+	struct PairKeyHash {
+		size_t operator()(const PairKey& k) const noexcept
+		{
+			return static_cast<size_t>(k.lo * 0x9e3779b97f4a7c15ULL ^ (k.hi + 0x632be59bd9b4e019ULL + (k.lo << 6)));
+		}
+	};
+
+	static constexpr uint32_t NO_CONTACT = UINT32_MAX;
+	// 正在碰撞的一对（按 key 升序存放在 current_pairs_ / prev_collision_pairs_ 中）
+	// - first/second 为按 key 排序后的 token；event 为本帧 events_ 中的下标，was_colliding 由与上一帧的归并得出
+	// - next_first/next_second 把同一物体参与的对串成链表（见 BasePhysics::contact_head_）；removed 表示一方已反注册、Exit 已派发
+	struct ActivePair {
+		PairKey key;
+		ObjManager::ObjToken first;
+		ObjManager::ObjToken second;
+		uint32_t event = 0;
+		uint32_t next_first = NO_CONTACT;
+		uint32_t next_second = NO_CONTACT;
+		bool was_colliding = false;
+		bool removed = false;
+	};
+
+	// narrowphase 结果缓存：以 PairKey 精确标识一对，记录测试时双方的 world shape 版本
+	// - 双方版本均未变化时直接复用 hit/event，不再调用 cf_collide
+	// - stamp 为最近一次被使用的帧号，Step 末尾清除本帧未使用且不再静止的条目
+	struct CachedPair {
+		uint64_t version_lo = 0;
+		uint64_t version_hi = 0;
+		uint32_t stamp = 0;
+		bool hit = false;
+		CollisionEvent event;
+	};
+
+	// narrowphase 任务：缓存未命中、需要真正调用 shapes_collide_world 的一对（结果写回 cache）
+	struct NarrowphaseJob {
+		CachedPair* cache = nullptr;
+		const Entry* a = nullptr;
+		const Entry* b = nullptr;
+		ShapeView aw;
+		ShapeView bw;
+	};
+	// 每个 narrowphase 任务的最小批量：少于该数量时不值得唤醒工作线程
+	static constexpr size_t NARROWPHASE_BATCH = 64;
+
+	// 休眠参数：运动条目连续 SLEEP_FRAMES 帧 world shape 未变化且速度为 0 时进入休眠
+	static constexpr uint16_t SLEEP_FRAMES = 30;
+
+	// 连续碰撞：被拉回接触处的条目再沿位移方向前进 CONTINUOUS_SKIN 像素，保证 narrowphase 仍能检测到该接触
+	static constexpr float CONTINUOUS_SKIN = 0.01f;
 
+	// 扫掠检测的最早命中：toi 为本帧位移中的比例（1 表示未命中），motion 为相对目标的位移
+	struct ContinuousHit {
+		float toi = 1.0f;
+		CF_V2 motion{ 0.0f, 0.0f };
+	};
+
+	// 静态分区的增量维护（实现见 Collider.cpp）
+	void update_static_entry(size_t idx) noexcept;
+	void remove_static_entry(size_t idx) noexcept;
+	void remove_dynamic_entry(size_t idx) noexcept;
+	void process_partition_refresh() noexcept;
+	// 判断 key 对应的条目是否静止（静态体或休眠体）且 world shape 版本仍为 version（用于沿用缓存的接触）
+	bool is_resting(uint64_t key, uint64_t version) const noexcept;
+	// 对开启连续碰撞的条目，按候选对计算与 SOLID 对象的最早接触时间，并把位置拉回接触处（在 narrowphase 之前调用）
+	void resolve_continuous() noexcept;
+
+	// 把 broadphase 条目引用（BroadphasePair::b 编码）解析为条目与 world shape；下标已失效或不满足 filter 时返回 nullptr
+	const Entry* resolve_ref(uint32_t ref, const QueryFilter& filter, ShapeView& out_shape) const noexcept;
+	// 空间查询的公共实现：取回与 bounds 相交的候选引用并排序去重，再以 shape 做精确测试
+	void query_overlaps(const CF_ShapeWrapper& shape, const CF_Aabb& bounds,
+		std::vector<ObjManager::ObjToken>& out, const QueryFilter& filter) const;
+	// 射线查询的公共实现：all 为 false 时只保留最近命中
+	void cast_ray(CF_V2 origin, CF_V2 dir, float max_distance, bool all,
+		std::vector<RaycastHit>& out_hits, const QueryFilter& filter) const;
+
+	// 运动分区（KINEMATIC + DYNAMIC）：每帧把全部 AABB 提交给 broadphase
 	std::vector<Entry> dynamic_entries_;
 	std::unordered_map<uint64_t, size_t> dynamic_token_map_;
 
+	// 静态分区（STATIC）：world shape / AABB 持久保存，仅在刷新队列中的条目被重新计算
 	std::vector<Entry> static_entries_;
 	std::unordered_map<uint64_t, size_t> static_token_map_;
-
-	std::unordered_map<uint64_t, std::vector<size_t>> grid_; // broadphase 网格映射
+	WorldShapeStore static_shapes_;       // 与 static_entries_ 一一对应的 world-space 形状与 AABB
+	std::vector<uint8_t> static_flags_;   // 与 static_entries_ 一一对应的 BroadphaseFlag
+	std::vector<CollisionFilter> static_filters_; // 与 static_entries_ 一一对应的碰撞层
+	bool static_dirty_ = false;           // 静态分区有变化，需要在本帧重新提交给 broadphase
+	size_t static_kinematic_listeners_ = 0; // 开启 kinematic_contacts 的静态体数量（非 0 时 KINEMATIC 也需查询静态分区）
+	std::vector<uint64_t> partition_refresh_queue_; // 待刷新的 token key（静态体移动 / BodyKind 改变 / 新注册静态体）
+
+	// 可插拔 broadphase 后端（默认均匀网格）与本帧候选对
+	std::unique_ptr<Broadphase> broadphase_ = std::make_unique<GridBroadphase>();
+	std::vector<BroadphasePair> pairs_;
+	AabbPairBatch pair_aabbs_;             // GRID：候选对的 SoA AABB，供批量重叠测试
+	std::vector<uint8_t> pair_overlap_;    // 与 pairs_ 一一对应的重叠结果
+	std::unordered_map<PairKey, CachedPair, PairKeyHash> pair_cache_;
+	std::vector<CachedPair*> narrow_results_;  // 按候选对顺序记录每对对应的缓存条目（合并事件时使用）
+	std::vector<NarrowphaseJob> narrow_jobs_;  // 本帧需要真正测试的对
+	WorkerPool workers_;
+	uint32_t frame_stamp_ = 0;
+	CF_Aabb activation_region_{};
+	bool has_activation_region_ = false;
+	mutable std::vector<uint32_t> query_refs_; // 空间查询的候选引用（复用容量）
+	mutable std::vector<RaycastHit> query_hits_; // Raycast 的临时命中缓冲
+	StepStats stats_;
 
 	std::vector<CollisionEvent> events_;
 
-	// 保存上一帧的碰撞对，用于生成 Enter / Exit 事件（pair key -> ordered token pair）
-	std::unordered_map<uint64_t, std::pair<ObjManager::ObjToken, ObjManager::ObjToken>> prev_collision_pairs_;
-
-	// 每帧使用的 world-shape 缓存与临时容器（避免频繁分配）
-	std::vector<CF_ShapeWrapper> world_shapes_;
-	std::vector<uint64_t> grid_keys_used_; // 记录已分配的 grid 键以便复用容器
-
-	// 合并与临时存储结构（用于合并一对的多个 contact）
-	std::unordered_map<uint64_t, CollisionEvent> merged_map_;
-	std::vector<uint64_t> merged_order_;
-	std::unordered_map<uint64_t, std::pair<ObjManager::ObjToken, ObjManager::ObjToken>> current_pairs_;
+	// 上一帧与本帧的碰撞对（均按 PairKey 升序），线性归并得到 Enter / Stay / Exit
+	std::vector<ActivePair> prev_collision_pairs_;
+	std::vector<ActivePair> current_pairs_;
+	std::vector<uint32_t> dispatch_order_; // current_pairs_ 下标，按接触距离排序的回调顺序
+	std::vector<uint32_t> exit_pairs_;     // prev_collision_pairs_ 中本帧消失的对的下标
+
+	// 每帧使用的 world-shape 缓存与临时容器（避免频繁分配），与 dynamic_entries_ 一一对应
+	WorldShapeStore moving_shapes_;
+	std::vector<uint8_t> moving_flags_;
+	std::vector<CF_Aabb> swept_aabbs_;       // 存在连续碰撞条目时提交给 broadphase 的 AABB（连续条目为扫掠包围盒）
+	std::vector<uint32_t> continuous_bodies_; // 本帧参与扫掠检测的运动条目下标
+	std::vector<int32_t> continuous_slot_;    // 运动条目下标 -> continuous_hits_ 下标（-1 表示未开启）
+	std::vector<ContinuousHit> continuous_hits_;
+	std::vector<CollisionFilter> moving_filters_;
 };
 
 // BasePhysics 为可碰撞对象提供通用的物理属性与形状管理接口：
@@ -132,6 +422,9 @@ private:
 
 	CF_ShapeWrapper shape; // 本地空间形状（由 set_shape 设置）
 	ColliderType collider_type = ColliderType::LIQUID; // 默认碰撞类型（可由上层更改）
+	BodyKind body_kind_ = BodyKind::DYNAMIC; // 运动分类（决定 PhysicsSystem 分区）
+	CollisionFilter collision_filter_{ CollisionLayer::DEFAULT, CollisionLayer::ALL }; // 碰撞层（broadphase 过滤）
+	bool kinematic_contacts_ = false; // 是否接收与 KINEMATIC 的接触（非 DYNAMIC 一侧的显式订阅）
 
 	// 旋转与枢轴参数（用于计算 world-space 形状）
 	float rotation_ = 0.0f;
@@ -165,14 +458,14 @@ public:
 
 	// 位置/速度/力 的基本操作接口
 	// - set_* 和 add_* 会标记 world_shape_dirty_（如果 shape 依赖于 position/pivot/rotation）
-	void set_position(const CF_V2& p) { _position = p; world_shape_dirty_ = true; position_dirty_ = true; }
+	void set_position(const CF_V2& p) { _position = p; invalidate_world_shape(); position_dirty_ = true; }
 	const CF_V2& get_position() const { return _position; }
 	void apply_velocity(float dt)
 	{
 		if (_velocity.x != 0.0f || _velocity.y != 0.0f) {
 			_position.x += _velocity.x * dt;
 			_position.y += _velocity.y * dt;
-			world_shape_dirty_ = true;
+			invalidate_world_shape();
 			position_dirty_ = true;
 		}
 	}
@@ -203,12 +496,54 @@ public:
 	}
 
 	// 碰撞类型接入（上层决定如何使用不同类型的 ColliderType）
-	void set_collider_type(ColliderType t) { collider_type = t; }
+	// - 静态体改变类型时需要刷新其在静态网格中的成员资格（VOID 不进入网格）
+	void set_collider_type(ColliderType t)
+	{
+		if (collider_type == t) return;
+		collider_type = t;
+		wake_up();
+		if (body_kind_ == BodyKind::STATIC) queue_partition_refresh();
+	}
 	ColliderType get_collider_type() const { return collider_type; }
 
+	// 运动分类接入：已注册对象改变分类时会在下一次 Step 开头迁移到对应分区
+	void set_body_kind(BodyKind k) noexcept
+	{
+		if (body_kind_ == k) return;
+		body_kind_ = k;
+		queue_partition_refresh();
+	}
+	BodyKind get_body_kind() const noexcept { return body_kind_; }
+
+	// 订阅与 KINEMATIC 的接触：默认 KINEMATIC 不与 STATIC / KINEMATIC 配对（现有脚本驱动对象只关心玩家等 DYNAMIC 对象）；
+	// 需要这类事件的对象（例如检测移动方块撞墙的 KINEMATIC、检测移动刺经过的 STATIC）开启后，只要一方开启该对就照常测试，
+	// 仍受碰撞层过滤
+	void set_kinematic_contacts(bool enable) noexcept
+	{
+		if (kinematic_contacts_ == enable) return;
+		kinematic_contacts_ = enable;
+		wake_up();
+		if (body_kind_ == BodyKind::STATIC) queue_partition_refresh();
+	}
+	bool get_kinematic_contacts() const noexcept { return kinematic_contacts_; }
+
+	// 碰撞层接入：category 为所属层，mask 为愿意与之碰撞的层（取值见 CollisionLayer）
+	// - 运动体每帧重新提交，立即生效；静态体需要重新提交静态分区
+	void set_collision_layer(uint32_t category, uint32_t mask = CollisionLayer::ALL) noexcept
+	{
+		if (collision_filter_.category == category && collision_filter_.mask == mask) return;
+		collision_filter_.category = category;
+		collision_filter_.mask = mask;
+		wake_up();
+		if (body_kind_ == BodyKind::STATIC) queue_partition_refresh();
+	}
+	uint32_t get_collision_category() const noexcept { return collision_filter_.category; }
+	uint32_t get_collision_mask() const noexcept { return collision_filter_.mask; }
+	const CollisionFilter& get_collision_filter() const noexcept { return collision_filter_; }
+
 	// 设置/获取本地形状；get_shape 会返回 world-space 的已处理形状（可能触发计算）
 	// - set_shape 标记 world_shape_dirty_，直到下次需要时才会转换为 world-space
-	void set_shape(const CF_ShapeWrapper& s) { shape = s; world_shape_dirty_ = true; }
+	void set_shape(const CF_ShapeWrapper& s) { shape = s; invalidate_world_shape(); }
 	const CF_ShapeWrapper& get_shape() const
 	{
 		if (world_shape_dirty_) tweak_shape_with_rotation();
@@ -220,21 +555,21 @@ public:
 	void set_rotation(float r) noexcept { 
 		if(r > pi) r -= 2 * pi;
 		else if (r < -pi) r += 2 * pi;
-		rotation_ = r; world_shape_dirty_ = true; 
+		rotation_ = r; invalidate_world_shape(); 
 	}
 	float get_rotation() const noexcept { return rotation_; }
 
-	void set_pivot(const CF_V2& p) noexcept { pivot_ = p; world_shape_dirty_ = true; }
+	void set_pivot(const CF_V2& p) noexcept { pivot_ = p; invalidate_world_shape(); }
 	CF_V2 get_pivot() const noexcept { return pivot_; }
 
 	// 缩放接口（水平 / 垂直），会影响形状的 world-space 转换
-	void scale_x(float sx) noexcept { scale_x_ = sx; world_shape_dirty_ = true; }
+	void scale_x(float sx) noexcept { scale_x_ = sx; invalidate_world_shape(); }
 	float get_scale_x() const noexcept { return scale_x_; }
-	void scale_y(float sy) noexcept { scale_y_ = sy; world_shape_dirty_ = true; }
+	void scale_y(float sy) noexcept { scale_y_ = sy; invalidate_world_shape(); }
 	float get_scale_y() const noexcept { return scale_y_; }
 
 	// 是否强制将 shape 视为 world-space：启用后 get_shape 将直接返回 shape（假设上层已经把它设置为 world-space）
-	void enable_world_shape(bool enable) noexcept { use_world_shape_ = enable; world_shape_dirty_ = true; }
+	void enable_world_shape(bool enable) noexcept { use_world_shape_ = enable; invalidate_world_shape(); }
 	bool is_world_shape_enabled() const noexcept { return use_world_shape_; }
 
 	// 强制立即更新 world shape（会调用 tweak_shape_with_rotation）
@@ -244,7 +579,24 @@ public:
 	uint64_t world_shape_version() const noexcept { return world_shape_version_; }
 
 	// 标记 world shape 脏（延迟更新），允许上层在修改多个属性后手动调用 force_update_world_shape 来一次性更新
-	void mark_world_shape_dirty() noexcept { world_shape_dirty_ = true; }
+	void mark_world_shape_dirty() noexcept { invalidate_world_shape(); }
+
+	// 休眠：静止的运动体由 PhysicsSystem 置为休眠，不再参与 narrowphase，已有接触按上一次结果继续产生 Stay；
+	// 位置/形状变化或速度不为 0 时在下一次 Step 自动唤醒
+	bool is_sleeping() const noexcept { return sleeping_; }
+	void set_allow_sleep(bool allow) noexcept { allow_sleep_ = allow; if (!allow) wake_up(); }
+	bool is_sleep_allowed() const noexcept { return allow_sleep_; }
+	void wake_up() noexcept { sleeping_ = false; rest_frames_ = 0; }
+
+	// 连续碰撞（CCD）：开启后 PhysicsSystem 把本帧位移（速度）视为一次扫掠，若途中会接触 SOLID 对象，
+	// 则在 narrowphase 之前把位置拉回到最早接触处，避免快速小物体穿过薄地形（默认关闭）
+	bool is_continuous() const noexcept { return continuous_; }
+	void set_continuous(bool enable) noexcept { continuous_ = enable; }
+
+	// 激活区域：always_active 的对象不受 PhysicsSystem 激活区域限制；is_region_active 为最近一次刷新的结果
+	bool is_always_active() const noexcept { return always_active_; }
+	void set_always_active(bool enable) noexcept { always_active_ = enable; }
+	bool is_region_active() const noexcept { return region_active_; }
 
 	// 位置脏标记相关接口
 	bool is_position_dirty() const noexcept { return position_dirty_; }
@@ -254,5 +606,42 @@ public:
 	const CF_ShapeWrapper& get_local_shape() const noexcept { return shape; }
 
 private:
+	friend class PhysicsSystem;
+
 	bool position_dirty_ = true; // 位置脏标记
+
+	// PhysicsSystem 注册状态（由 PhysicsSystem 维护）：用于静态体移动时通知分区刷新
+	bool physics_registered_ = false;
+	bool partition_refresh_queued_ = false;
+	uint64_t physics_key_ = 0;
+
+	// 休眠状态（由 PhysicsSystem 维护）：rest_version_ 为开始静止时的 world shape 版本
+	bool allow_sleep_ = true;
+	bool sleeping_ = false;
+	uint16_t rest_frames_ = 0;
+	uint64_t rest_version_ = 0;
+
+	bool continuous_ = false;
+
+	bool always_active_ = false;
+	bool region_active_ = true;
+
+	// 活跃接触链表（由 PhysicsSystem 维护）：contact_head_ 为 prev_collision_pairs_ 中首个含本物体的对，
+	// 仅当 contact_stamp_ 等于系统的 frame_stamp_ 时有效，过期即视为空表，因此每帧无需逐个清空
+	uint32_t contact_head_ = UINT32_MAX;
+	uint32_t contact_stamp_ = 0;
+
+	// 标记 world shape 脏；静态体会额外通知 PhysicsSystem 在下一次 Step 重新插入静态网格
+	void invalidate_world_shape() noexcept
+	{
+		world_shape_dirty_ = true;
+		if (body_kind_ == BodyKind::STATIC) queue_partition_refresh();
+	}
+
+	void queue_partition_refresh() noexcept
+	{
+		if (!physics_registered_ || partition_refresh_queued_) return;
+		partition_refresh_queued_ = true;
+		PhysicsSystem::Instance().QueuePartitionRefresh(physics_key_);
+	}
 };
\ No newline at end of file
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cute.h>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "cell_grid.h"
+#include "aabb_tree.h"
+
+// broadphase 后端选择（可在运行时通过 PhysicsSystem::SetBroadphaseMode 切换）
+// - GRID：均匀网格（CellGrid），适合尺寸相近、分布均匀的对象
+// - SWEEP_AND_PRUNE：沿 x 轴排序扫描，帧间使用插入排序利用时间相干性；对跨越多个格子的长条对象不会重复产生候选对
+// - AABB_TREE：动态包围盒树（胖 AABB），对象在胖 AABB 内移动时不更新树；尺寸差异大、分布稀疏的场景以及大量空间查询时更合适
+enum class BroadphaseMode {
+	GRID,
+	SWEEP_AND_PRUNE,
+	AABB_TREE
+};
+
+// broadphase 输入标志（每个条目一个字节）
+namespace BroadphaseFlag {
+	constexpr uint8_t ACTIVE = 1 << 0;       // 参与 broadphase（VOID 等不参与碰撞的条目不设置）
+	constexpr uint8_t QUERY_STATIC = 1 << 1; // 运动条目是否需要与静态条目配对（KINEMATIC 仅在订阅了 kinematic 接触时需要）
+}
+
+// 碰撞层过滤：category 为条目所属层（通常一位），mask 为愿意与之碰撞的层集合
+// - 一对条目只有在双方互相接受（a.category & b.mask 且 b.category & a.mask）时才会产生候选对，
+//   被拒绝的对在 broadphase 内直接丢弃，不会进入 narrowphase
+struct CollisionFilter {
+	uint32_t category = 1u;
+	uint32_t mask = 0xFFFFFFFFu;
+
+	bool Accepts(const CollisionFilter& other) const noexcept
+	{
+		return (category & other.mask) != 0 && (other.category & mask) != 0;
+	}
+};
+
+// 候选对：a 为运动条目下标；b 的最高位 STATIC_BIT 表示静态条目，其余位为对应分区中的下标
+// - 运动-运动候选对保证 a < b
+// - 空间查询返回的条目引用使用与 b 相同的编码
+struct BroadphasePair {
+	static constexpr uint32_t STATIC_BIT = 0x80000000u;
+	uint32_t a;
+	uint32_t b;
+};
+
+// Broadphase 为 PhysicsSystem 的可插拔 broadphase 接口，面向使用者说明：
+// - PhysicsSystem 负责计算每个条目的 world-space AABB、标志与碰撞层，broadphase 只负责产生“可能相交”且碰撞层互相接受的候选对；
+//   BodyKind 过滤与 narrowphase 仍由 PhysicsSystem 执行。
+// - 静态条目通过 SetStatic 一次性提交，只在静态分区发生变化的帧调用；运动条目每帧通过 CollectPairs 提交。
+// - 每对条目在一帧内最多产生一次（PhysicsSystem 不再对候选对去重）；允许产生 AABB 实际不相交的候选对，但不得漏报。
+class Broadphase {
+public:
+	virtual ~Broadphase() noexcept = default;
+
+	virtual BroadphaseMode Mode() const noexcept = 0;
+
+	// 网格类后端使用的格子尺寸（来自 PhysicsSystem::Step 的 cell_size）；其它后端可忽略
+	virtual void SetCellSize(float cell_size) noexcept { (void)cell_size; }
+
+	// 提交全部静态条目的 AABB、标志与碰撞层（三数组等长，下标即静态分区下标）
+	virtual void SetStatic(const std::vector<CF_Aabb>& aabbs, const std::vector<uint8_t>& flags,
+		const std::vector<CollisionFilter>& filters) = 0;
+
+	// 提交本帧运动条目的 AABB、标志与碰撞层，并把候选对追加到 out
+	virtual void CollectPairs(const std::vector<CF_Aabb>& aabbs, const std::vector<uint8_t>& flags,
+		const std::vector<CollisionFilter>& filters, std::vector<BroadphasePair>& out) = 0;
+
+	// 空间查询（基于最近一次 SetStatic / CollectPairs 提交的数据）：把 AABB 可能与 box 相交的活跃条目引用追加到 out
+	// - 与 CollectPairs 相同，允许重复或实际不相交的结果，但不得漏报
+	virtual void QueryAabb(const CF_Aabb& box, std::vector<uint32_t>& out) const = 0;
+
+	// 把 AABB 可能被线段 origin + dir * t（t ∈ [0, max_t]）穿过的活跃条目引用追加到 out
+	// - 默认实现退化为线段包围盒的 QueryAabb
+	virtual void QueryRay(CF_V2 origin, CF_V2 dir, float max_t, std::vector<uint32_t>& out) const;
+
+	virtual size_t GetEstimatedMemoryUsageBytes() const noexcept = 0;
+};
+
+// 均匀网格后端：静态网格持久保存，运动网格每帧以 counting sort 重建
+// - 跨越多个格子的两个条目只在它们共享的第一个格子（两者格子范围交集的左下角）产生候选对，其余共享格子直接跳过
+class GridBroadphase final : public Broadphase {
+public:
+	BroadphaseMode Mode() const noexcept override { return BroadphaseMode::GRID; }
+	void SetCellSize(float cell_size) noexcept override;
+	void SetStatic(const std::vector<CF_Aabb>& aabbs, const std::vector<uint8_t>& flags,
+		const std::vector<CollisionFilter>& filters) override;
+	void CollectPairs(const std::vector<CF_Aabb>& aabbs, const std::vector<uint8_t>& flags,
+		const std::vector<CollisionFilter>& filters, std::vector<BroadphasePair>& out) override;
+	void QueryAabb(const CF_Aabb& box, std::vector<uint32_t>& out) const override;
+	size_t GetEstimatedMemoryUsageBytes() const noexcept override;
+
+	size_t MovingCellCount() const noexcept { return moving_grid_.CellCount(); }
+	size_t MovingRefCount() const noexcept { return moving_grid_.RefCount(); }
+	size_t StaticCellCount() const noexcept { return static_grid_.CellCount(); }
+	size_t StaticRefCount() const noexcept { return static_grid_.RefCount(); }
+	size_t LastDuplicatesSkipped() const noexcept { return last_duplicates_skipped_; }
+
+private:
+	struct CellRange {
+		int32_t gx0 = 0;
+		int32_t gy0 = 0;
+		int32_t gx1 = -1; // gx1 < gx0 表示不在网格中
+		int32_t gy1 = -1;
+	};
+
+	CellRange to_range(const CF_Aabb& aabb) const noexcept;
+	void rebuild_static() noexcept;
+
+	float cell_size_ = 64.0f;
+	std::vector<CF_Aabb> static_aabbs_;
+	std::vector<uint8_t> static_flags_;
+	std::vector<CollisionFilter> static_filters_;
+	std::vector<CellRange> static_ranges_;
+	std::vector<CellRange> moving_ranges_;
+	size_t last_duplicates_skipped_ = 0; // 上一次 CollectPairs 因共享多个格子而跳过的重复对数
+	CellGrid static_grid_;
+	CellGrid moving_grid_;
+};
+
+// 单轴（x）扫描与剪枝后端：
+// - 运动条目的排序序列跨帧保留，每帧只做插入排序（对象移动很少时接近 O(n)）
+// - 静态条目在 SetStatic 时整体排序一次
+// - 扫描时同时检查 y 轴重叠，输出的候选对均为 AABB 相交对
+// - 空间查询沿排序序列扫描到 min.x 超出查询范围为止
+class SweepAndPruneBroadphase final : public Broadphase {
+public:
+	BroadphaseMode Mode() const noexcept override { return BroadphaseMode::SWEEP_AND_PRUNE; }
+	void SetStatic(const std::vector<CF_Aabb>& aabbs, const std::vector<uint8_t>& flags,
+		const std::vector<CollisionFilter>& filters) override;
+	void CollectPairs(const std::vector<CF_Aabb>& aabbs, const std::vector<uint8_t>& flags,
+		const std::vector<CollisionFilter>& filters, std::vector<BroadphasePair>& out) override;
+	void QueryAabb(const CF_Aabb& box, std::vector<uint32_t>& out) const override;
+	size_t GetEstimatedMemoryUsageBytes() const noexcept override;
+
+	// 最近一帧插入排序的交换次数（衡量帧间相干性）
+	size_t LastSortSwaps() const noexcept { return last_sort_swaps_; }
+
+private:
+	void sync_moving_order(size_t count);
+
+	std::vector<CF_Aabb> static_aabbs_;
+	std::vector<CollisionFilter> static_filters_;
+	std::vector<CF_Aabb> moving_aabbs_;  // 最近一次 CollectPairs 的运动条目 AABB（供空间查询使用）
+	std::vector<uint8_t> moving_flags_;
+	std::vector<uint32_t> static_order_; // 按 min.x 排序的活跃静态条目下标
+	std::vector<uint32_t> moving_order_; // 按 min.x 排序的运动条目下标（跨帧保留）
+	std::vector<uint8_t> moving_present_;
+	std::vector<uint32_t> active_moving_; // 扫描时的活动集合
+	std::vector<uint32_t> active_static_;
+	size_t last_sort_swaps_ = 0;
+};
+
+// 动态 AABB 树后端：静态与运动条目各一棵 AabbTree，代理与分区下标一一对应（user_data 即下标）
+// - 运动条目使用胖 AABB（margin + 位移预测），实际 AABB 仍在胖 AABB 内时不修改树；
+//   分区 swap-pop 后，下标 k 的代理只是被移动到新条目的 AABB，不需要额外的映射表
+// - 静态树使用紧 AABB，仅在 SetStatic 时对 AABB 变化的条目更新
+// - 候选对为“紧 AABB 与对方胖 AABB 相交”，空间查询与射线查询直接在树上进行（O(log n)）
+class AabbTreeBroadphase final : public Broadphase {
+public:
+	// margin 为运动条目胖 AABB 的扩张量（像素）
+	explicit AabbTreeBroadphase(float margin = 8.0f) noexcept : margin_(margin) {}
+
+	BroadphaseMode Mode() const noexcept override { return BroadphaseMode::AABB_TREE; }
+	void SetStatic(const std::vector<CF_Aabb>& aabbs, const std::vector<uint8_t>& flags,
+		const std::vector<CollisionFilter>& filters) override;
+	void CollectPairs(const std::vector<CF_Aabb>& aabbs, const std::vector<uint8_t>& flags,
+		const std::vector<CollisionFilter>& filters, std::vector<BroadphasePair>& out) override;
+	void QueryAabb(const CF_Aabb& box, std::vector<uint32_t>& out) const override;
+	void QueryRay(CF_V2 origin, CF_V2 dir, float max_t, std::vector<uint32_t>& out) const override;
+	size_t GetEstimatedMemoryUsageBytes() const noexcept override;
+
+	// 最近一帧真正修改了树结构的运动代理数（实际 AABB 移出胖 AABB、新建或删除）
+	size_t LastTreeUpdates() const noexcept { return last_tree_updates_; }
+	int32_t MovingTreeHeight() const noexcept { return moving_tree_.Height(); }
+
+private:
+	float margin_;
+	AabbTree static_tree_;
+	AabbTree moving_tree_;
+	std::vector<int32_t> static_proxies_;  // 静态分区下标 -> 代理（NULL_NODE 表示不在树中）
+	std::vector<CF_Aabb> static_aabbs_;    // 静态代理插入时的紧 AABB（用于判断是否需要更新）
+	std::vector<CollisionFilter> static_filters_;
+	std::vector<int32_t> moving_proxies_;  // 运动分区下标 -> 代理
+	std::vector<CF_Aabb> moving_aabbs_;    // 上一帧的紧 AABB（用于计算位移与生成候选对）
+	size_t last_tree_updates_ = 0;
+};
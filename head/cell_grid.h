@@ -0,0 +1,83 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// CellGrid 为 PhysicsSystem 使用的扁平均匀网格（broadphase 加速结构），面向使用者说明：
+// - 以 (gx, gy) 格子坐标为键，格子表是一张开放寻址（线性探测）哈希表，条目只存 key 与在 items_ 中的 [start, start + count) 区间；
+//   所有格子的内容连续存放在同一个 items_ 缓冲区中，不再为每个格子分配独立的 std::vector。
+// - 构建方式为 counting sort：Begin() 开始一次构建，Add() 记录 (格子, 值) 对，Finalize() 统计每格数量、做前缀和并一次性散列写入 items_。
+// - 表项使用代数戳（stamp）判定有效性，重建时无需清空整张表；容器容量在多次构建间复用，稳定后每帧无堆分配。
+// 语义契约：
+// - Finalize() 之前 Query() 的结果未定义；每次 Begin() 会使之前的构建失效。
+// - 同一格子内值的顺序与 Add() 调用顺序一致（稳定），保证碰撞事件顺序可复现。
+// - 非线程安全；构建完成后的 Query() 为只读操作。
+class CellGrid {
+public:
+	// 某个格子内的值区间（指向 items_ 的连续内存）
+	struct Span {
+		const uint32_t* first = nullptr;
+		const uint32_t* last = nullptr;
+		const uint32_t* begin() const noexcept { return first; }
+		const uint32_t* end() const noexcept { return last; }
+		bool empty() const noexcept { return first == last; }
+	};
+
+	// 开始新一次构建；expected_refs 为预估的 (格子, 值) 对数量，用于预留容量
+	void Begin(size_t expected_refs = 0);
+
+	// 把 value 放入格子 (gx, gy)
+	void Add(int32_t gx, int32_t gy, uint32_t value)
+	{
+		pending_.push_back(Pending{ cell_key(gx, gy), value });
+	}
+
+	// 完成构建：counting sort 写入连续的 items_
+	void Finalize();
+
+	// 查询格子 (gx, gy) 中的值；格子不存在时返回空区间
+	Span Query(int32_t gx, int32_t gy) const noexcept;
+
+	size_t CellCount() const noexcept { return used_slots_.size(); }
+	size_t RefCount() const noexcept { return items_.size(); }
+	size_t GetEstimatedMemoryUsageBytes() const noexcept;
+
+private:
+	struct Slot {
+		uint64_t key = 0;
+		uint32_t stamp = 0;  // 与 stamp_ 相等时该槽位在本次构建中有效
+		uint32_t start = 0;  // 在 items_ 中的起始下标
+		uint32_t count = 0;  // 格子内值的数量
+		uint32_t cursor = 0; // Finalize 写入时的游标
+	};
+
+	struct Pending {
+		uint64_t key;
+		uint32_t value;
+	};
+
+	static uint64_t cell_key(int32_t x, int32_t y) noexcept
+	{
+		return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint64_t>(static_cast<uint32_t>(y));
+	}
+
+	// splitmix64 的混合步骤，避免相邻格子键在低位聚集
+	static uint64_t hash_key(uint64_t k) noexcept
+	{
+		k ^= k >> 30; k *= 0xbf58476d1ce4e5b9ULL;
+		k ^= k >> 27; k *= 0x94d049bb133111ebULL;
+		k ^= k >> 31;
+		return k;
+	}
+
+	uint32_t find_or_insert(uint64_t key) noexcept;
+
+	std::vector<Slot> slots_;          // 开放寻址表，容量为 2 的幂
+	uint64_t mask_ = 0;
+	uint32_t stamp_ = 0;
+	std::vector<uint32_t> used_slots_; // 本次构建使用过的槽位（按首次出现顺序）
+	std::vector<Pending> pending_;     // Add 收集的 (格子, 值) 对
+	std::vector<uint32_t> pending_slot_; // 与 pending_ 对应的槽位下标（避免二次探测）
+	std::vector<uint32_t> items_;      // 所有格子的值，按格子连续存放
+};
@@ -19,9 +19,17 @@ public:
 
     void Register(BaseObject* obj) noexcept;
     void Unregister(BaseObject* obj) noexcept;
+    // Drops every entry at once (room teardown). Destructors that call Unregister
+    // afterwards return immediately instead of scanning the table.
+    void Clear() noexcept;
 
     void DrawAll();
 
+    // Render interpolation factor in [0, 1]: fraction of a fixed physics step left in
+    // the main-loop accumulator. DrawAll draws each object at GetRenderPosition(alpha).
+    void SetInterpolationAlpha(float alpha) noexcept { m_interp_alpha = alpha < 0.0f ? 0.0f : (alpha > 1.0f ? 1.0f : alpha); }
+    float GetInterpolationAlpha() const noexcept { return m_interp_alpha; }
+
     size_t GetEstimatedMemoryUsageBytes() const noexcept;
 
 private:
@@ -34,4 +42,5 @@ private:
     mutable std::mutex m_mutex;
 
     uint64_t m_next_reg_index = 1;
+    float m_interp_alpha = 1.0f;
 };
\ No newline at end of file
@@ -24,7 +24,76 @@ enum class MouseState {
 
 // Input 命名空间提供一些便捷的输入查询函数，包装了 cute_input 的底层接口。
 // 约定：这些函数均为 inline 且 noexcept，适合在游戏主循环中频繁调用。
+// 固定步长：主循环每个渲染帧只调用一次 app_update，却可能执行 0~N 个逻辑步。
+// 为使 edge 状态（Up/Down/Repeatable/DoubleClick）既不丢失也不重复，主循环在 app_update 后调用 LatchFrameEdges
+// 把本帧 edge 累积到锁存位，每执行完一个逻辑步调用 ClearLatchedEdges；锁存启用后 edge 查询均读取锁存位。
 namespace Input {
+	namespace detail {
+		struct EdgeLatch {
+			std::bitset<CF_KEY_COUNT> key_pressed;
+			std::bitset<CF_KEY_COUNT> key_released;
+			std::bitset<CF_KEY_COUNT> key_repeated;
+			std::bitset<CF_MOUSE_BUTTON_COUNT> mouse_pressed;
+			std::bitset<CF_MOUSE_BUTTON_COUNT> mouse_released;
+			std::bitset<CF_MOUSE_BUTTON_COUNT> mouse_double_clicked;
+			bool enabled = false; // 未调用过 LatchFrameEdges 时直接查询 cute_input
+		};
+		inline EdgeLatch& Latch() noexcept { static EdgeLatch latch; return latch; }
+
+		inline bool KeyPressed(CF_KeyButton key) noexcept {
+			const EdgeLatch& l = Latch();
+			return l.enabled ? l.key_pressed.test(static_cast<std::size_t>(key)) : cf_key_just_pressed(key);
+		}
+		inline bool KeyReleased(CF_KeyButton key) noexcept {
+			const EdgeLatch& l = Latch();
+			return l.enabled ? l.key_released.test(static_cast<std::size_t>(key)) : cf_key_just_released(key);
+		}
+		inline bool KeyRepeated(CF_KeyButton key) noexcept {
+			const EdgeLatch& l = Latch();
+			return l.enabled ? l.key_repeated.test(static_cast<std::size_t>(key)) : cf_key_repeating(key);
+		}
+		inline bool MousePressed(CF_MouseButton button) noexcept {
+			const EdgeLatch& l = Latch();
+			return l.enabled ? l.mouse_pressed.test(static_cast<std::size_t>(button)) : cf_mouse_just_pressed(button);
+		}
+		inline bool MouseReleased(CF_MouseButton button) noexcept {
+			const EdgeLatch& l = Latch();
+			return l.enabled ? l.mouse_released.test(static_cast<std::size_t>(button)) : cf_mouse_just_released(button);
+		}
+		inline bool MouseDoubleClicked(CF_MouseButton button) noexcept {
+			const EdgeLatch& l = Latch();
+			return l.enabled ? l.mouse_double_clicked.test(static_cast<std::size_t>(button)) : cf_mouse_double_clicked(button);
+		}
+	}
+
+	// 在每次 app_update 之后调用：把本帧的 edge 并入锁存位（尚未被逻辑步消耗的 edge 保留）
+	inline void LatchFrameEdges() noexcept {
+		detail::EdgeLatch& l = detail::Latch();
+		l.enabled = true;
+		for (int i = 0; i < CF_KEY_COUNT; ++i) {
+			CF_KeyButton key = static_cast<CF_KeyButton>(i);
+			if (cf_key_just_pressed(key)) l.key_pressed.set(static_cast<std::size_t>(i));
+			if (cf_key_just_released(key)) l.key_released.set(static_cast<std::size_t>(i));
+			if (cf_key_repeating(key)) l.key_repeated.set(static_cast<std::size_t>(i));
+		}
+		for (int i = 0; i < CF_MOUSE_BUTTON_COUNT; ++i) {
+			CF_MouseButton b = static_cast<CF_MouseButton>(i);
+			if (cf_mouse_just_pressed(b)) l.mouse_pressed.set(static_cast<std::size_t>(i));
+			if (cf_mouse_just_released(b)) l.mouse_released.set(static_cast<std::size_t>(i));
+			if (cf_mouse_double_clicked(b)) l.mouse_double_clicked.set(static_cast<std::size_t>(i));
+		}
+	}
+	// 在每个逻辑步结束后调用：edge 只交给第一个逻辑步
+	inline void ClearLatchedEdges() noexcept {
+		detail::EdgeLatch& l = detail::Latch();
+		l.key_pressed.reset();
+		l.key_released.reset();
+		l.key_repeated.reset();
+		l.mouse_pressed.reset();
+		l.mouse_released.reset();
+		l.mouse_double_clicked.reset();
+	}
+
 	inline bool IsKeyInState(CF_KeyButton key, KeyState state) noexcept;
 	inline bool KeyDown(CF_KeyButton& out_key) noexcept;
 	inline bool KeysDown(std::bitset<CF_KEY_COUNT>& out_keys) noexcept;
@@ -59,15 +128,15 @@ namespace Input {
 inline bool Input::IsKeyInState(CF_KeyButton key, KeyState state) noexcept {
 	switch (state) {
 	case KeyState::Up:
-		return cf_key_just_released(key);
+		return detail::KeyReleased(key);
 	case KeyState::Down:
-		return cf_key_just_pressed(key);
+		return detail::KeyPressed(key);
 	case KeyState::Hold:
-		return cf_key_down(key) || cf_key_just_pressed(key);
+		return cf_key_down(key) || detail::KeyPressed(key);
 	case KeyState::Hang:
-		return cf_key_up(key) || cf_key_just_released(key);
+		return cf_key_up(key) || detail::KeyReleased(key);
 	case KeyState::Repeatable:
-		return cf_key_just_pressed(key) || cf_key_repeating(key);
+		return detail::KeyPressed(key) || detail::KeyRepeated(key);
 	default:
 		return false;
 	}
@@ -77,14 +146,14 @@ inline bool Input::IsKeyInState(CF_KeyButton key, KeyState state) noexcept {
 // 优先检测刚按下（cf_key_just_pressed），同时也包含重复触发（cf_key_repeating）。
 // 若无按键触发，将 out_key 设为 CF_KEY_UNKNOWN 并返回 false。
 inline bool Input::KeyDown(CF_KeyButton& out_key) noexcept {
-	if (!cf_key_just_pressed(CF_KEY_ANY)) {
+	if (!detail::KeyPressed(CF_KEY_ANY)) {
 		out_key = CF_KEY_UNKNOWN;
 		return false;
 	}
 	for (int i = 1; i < CF_KEY_COUNT; ++i) { // 从 1 开始跳过 CF_KEY_UNKNOWN(0)
 		CF_KeyButton key = static_cast<CF_KeyButton>(i);
 		if (key == CF_KEY_ANY) continue; // 跳过 CF_KEY_ANY
-		if (cf_key_just_pressed(key)) {
+		if (detail::KeyPressed(key)) {
 			out_key = key;
 			return true;
 		}
@@ -102,7 +171,7 @@ inline bool Input::KeysDown(std::bitset<CF_KEY_COUNT>& out_keys) noexcept {
 	for (int i = 1; i < CF_KEY_COUNT; ++i) {
 		if (i == CF_KEY_ANY) continue;
 		CF_KeyButton key = static_cast<CF_KeyButton>(i);
-		if (cf_key_just_pressed(key) || cf_key_repeating(key)) {
+		if (detail::KeyPressed(key) || detail::KeyRepeated(key)) {
 			out_keys.set(static_cast<std::size_t>(i));
 			any = true;
 		}
@@ -115,15 +184,15 @@ inline bool Input::KeysDown(std::bitset<CF_KEY_COUNT>& out_keys) noexcept {
 inline bool Input::IsMouseInState(CF_MouseButton button, MouseState state) noexcept {
 	switch (state) {
 	case MouseState::Up:
-		return cf_mouse_just_released(button);
+		return detail::MouseReleased(button);
 	case MouseState::Down:
-		return cf_mouse_just_pressed(button);
+		return detail::MousePressed(button);
 	case MouseState::Hold:
-		return cf_mouse_down(button) || cf_mouse_just_pressed(button);
+		return cf_mouse_down(button) || detail::MousePressed(button);
 	case MouseState::Hang:
-		return (!cf_mouse_down(button)) || cf_mouse_just_released(button);
+		return (!cf_mouse_down(button)) || detail::MouseReleased(button);
 	case MouseState::DoubleClick:
-		return cf_mouse_double_clicked(button);
+		return detail::MouseDoubleClicked(button);
 	case MouseState::DoubleClickAndHold:
 		return cf_mouse_double_click_held(button);
 	default:
@@ -136,7 +205,7 @@ inline bool Input::IsMouseInState(CF_MouseButton button, MouseState state) noexc
 inline bool Input::MouseDown(CF_MouseButton& out_button) noexcept {
 	for (int i = 0; i < CF_MOUSE_BUTTON_COUNT; ++i) {
 		CF_MouseButton b = static_cast<CF_MouseButton>(i);
-		if (cf_mouse_just_pressed(b)) {
+		if (detail::MousePressed(b)) {
 			out_button = b;
 			return true;
 		}
@@ -154,7 +223,7 @@ inline bool Input::MouseButtonsDown(std::bitset<CF_MOUSE_BUTTON_COUNT>& out_butt
 	for (int i = 0; i < CF_MOUSE_BUTTON_COUNT; ++i) {
 		CF_MouseButton b = static_cast<CF_MouseButton>(i);
 		// 这里把“刚按下”与“当前按下”都视为被按下（与 KeysDown 行为保持相近）
-		if (cf_mouse_just_pressed(b) || cf_mouse_down(b)) {
+		if (detail::MousePressed(b) || cf_mouse_down(b)) {
 			out_buttons.set(static_cast<std::size_t>(i));
 			any = true;
 		}
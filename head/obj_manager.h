@@ -10,6 +10,8 @@
 #include <cstddef>
 
 #include "object_token.h"
+#include "object_pool.h"
+#include "tag_registry.h"
 
 #ifndef APPLIANCE
 #define APPLIANCE [[deprecated("APPLIANCE: 涉及物理量的每帧更新，已在类内部完成。除非你需要单帧内多次更新，否则请勿使用该接口。")]]
@@ -18,14 +20,29 @@
 // 前置声明，避免头文件循环依赖
 class BaseObject;
 
+// 对象实际需要的逐帧钩子（位掩码）。Create<T> 在编译期检测 T 是否重写了对应虚函数，
+// 类型也可以用 `static constexpr uint8_t kUpdateHooks = UpdateHooks::...;` 显式声明（优先于检测结果）。
+struct UpdateHooks {
+    enum : uint8_t {
+        NONE = 0,
+        START_FRAME = 1 << 0, // 重写了 StartFrame
+        UPDATE = 1 << 1,      // 重写了 Update
+        END_FRAME = 1 << 2,   // 重写了 EndFrame
+        ALL = START_FRAME | UPDATE | END_FRAME,
+    };
+};
+
 // ObjManager 为应用提供对象生命周期管理与句柄（token）系统，面向使用者说明：
 // - 提供基于 `ObjToken` 的对象引用与验证机制，避免裸指针悬挂问题。主流用法：
 //     auto tok = objs.Create<MyObject>(...); // 返回 pending token（pending id 存放在 token.index）
 //     // 下一帧 UpdateAll 提交后，pending token 会被升级为真实 token（index -> objects_ 槽索引），可使用 TryGetRegisteration / operator[] 访问
-// - 支持延迟创建（CreateEntry 将对象放入 pending_creates_ 并立即调用 Start()，但直到下一帧 UpdateAll 才合并到 objects_ 且注册到 PhysicsSystem）
-//   这样做可避免在更新循环中动态分配导致迭代器失效，并允许在 pending 阶段提前访问对象（operator[] 直接查找 pending_creates_）。
+// - 支持延迟创建（CreateEntry 在 objects_ 中预留真实槽位并立即调用 Start()，但直到下一帧 UpdateAll 才把该槽标记为存活并注册到 PhysicsSystem）
+//   pending token 与真实 token 指向同一个 (index, generation)，解析只需检查该槽是否已提交，不需要额外的映射表；
+//   pending 阶段可通过 operator[] 提前访问对象。
+// - 对象存储来自按具体类型划分的对象池（TypedObjectPool<T>），Entry 以带 PooledDeleter 的 ObjPtr 持有对象，销毁时归还所属池而非 delete。
 // - 支持延迟销毁（DestroyExisting 会将真实 token 入队，实际销毁在下一次 UpdateAll 的安全点执行；DestroyPending 会清理尚未合并的 pending）。
 // - UpdateAll() 是统一的帧更新入口，职责包括：FrameEnterApply、PhysicsSystem::Step、Update、FrameExitApply、处置销毁、提交 pending-create，并支持 skip_update_this_frame 标记跳过当帧更新。
+// - 钩子分桶：只有重写了 Update 的对象进入 Update 遍历（按类型分组、组内按 index），未重写 StartFrame/EndFrame 的对象在帧首/帧尾不做虚调用。
 // 语义契约：
 // - ObjManager 的大部分接口不是线程安全的，应在主线程的游戏循环中使用。
 // - operator[] 在 token 无效时将抛出 std::out_of_range（并写入 std::cerr），调用方应捕获或先使用 IsValid/TryGetRegisteration 检查。
@@ -37,9 +54,10 @@ public:
     ObjManager& operator=(const ObjManager&) = delete;
 
     using ObjToken = ::ObjToken;
+    using ObjPtr = std::unique_ptr<BaseObject, PooledDeleter>;
 
-    // Create: 立即构造对象并调用 Start()，但对象会被放入 pending_creates_，直到下一帧 UpdateAll 的提交阶段才合并到 objects_ 并返回真正的 index/generation。
-    // 返回 PendingToken 便于调用者追踪对象。pending token 既可在 pending 阶段通过 operator[] 或 TryGetRegisteration 访问。
+    // Create: 立即构造对象并调用 Start()，对象占用预留的槽位但处于 pending 状态，直到下一帧 UpdateAll 的提交阶段才参与更新与物理。
+    // 返回 PendingToken（index/generation 即提交后的真实值）便于调用者追踪对象。pending token 既可在 pending 阶段通过 operator[] 或 TryGetRegisteration 访问。
     template <typename T, typename... Args>
     ObjToken Create(Args&&... args)
     {
@@ -54,11 +72,39 @@ public:
     ObjToken Create(Init&& initializer, Args&&... args)
     {
         static_assert(std::is_base_of_v<BaseObject, T>, "T must derive from BaseObject");
-        auto obj = std::make_unique<T>(std::forward<Args>(args)...);
+        TypedObjectPool<T>& pool = PoolFor<T>();
+        T* raw = pool.Allocate(std::forward<Args>(args)...);
+        ObjPtr obj(raw, PooledDeleter{ &pool });
         if (initializer) {
-            std::forward<Init>(initializer)(static_cast<T*>(obj.get()));
+            std::forward<Init>(initializer)(raw);
+        }
+        return CreateEntry(std::move(obj), static_cast<uint32_t>(PoolTypeId<T>()), HooksOf<T>());
+    }
+
+    // T 需要的逐帧钩子：显式声明的 kUpdateHooks 优先；否则比较成员函数指针类型，
+    // 与 BaseObject 自身的版本相同即未重写（无法取地址时，例如重写声明为 private，保守视为已重写）
+    template <typename T>
+    static constexpr uint8_t HooksOf() noexcept
+    {
+        if constexpr (requires { T::kUpdateHooks; }) {
+            return static_cast<uint8_t>(T::kUpdateHooks);
+        }
+        else {
+            uint8_t hooks = UpdateHooks::NONE;
+            if constexpr (requires { &T::StartFrame; }) {
+                if (!std::is_same_v<decltype(&T::StartFrame), void (BaseObject::*)()>) hooks |= UpdateHooks::START_FRAME;
+            }
+            else hooks |= UpdateHooks::START_FRAME;
+            if constexpr (requires { &T::Update; }) {
+                if (!std::is_same_v<decltype(&T::Update), void (BaseObject::*)()>) hooks |= UpdateHooks::UPDATE;
+            }
+            else hooks |= UpdateHooks::UPDATE;
+            if constexpr (requires { &T::EndFrame; }) {
+                if (!std::is_same_v<decltype(&T::EndFrame), void (BaseObject::*)()>) hooks |= UpdateHooks::END_FRAME;
+            }
+            else hooks |= UpdateHooks::END_FRAME;
+            return hooks;
         }
-        return CreateEntry(std::unique_ptr<BaseObject>(static_cast<BaseObject*>(obj.release())));
     }
 
     // 验证 token 是否为当前有效的已合并对象（不考虑 pending 情况）
@@ -66,7 +112,7 @@ public:
 
     // operator[] 重载：通过 ObjToken 直接取得对象的左值引用。
     // 语义：若 token 无效或对象已被销毁，会抛出 std::out_of_range（并写入 std::cerr）。
-    // 注意：如果传入的是 pending token（isRegitsered==false），const/non-const non-const 版本会尝试解析为 pending（访问 pending_creates_）或使用 TryGetRegisteration 升级为真实 token。
+    // 注意：如果传入的是 pending token（isRegitsered==false），const/non-const non-const 版本会直接返回仍处于 pending 的对象，或使用 TryGetRegisteration 升级为真实 token。
     BaseObject& operator[](ObjToken& token);
     BaseObject& operator[](const ObjToken& token);
     const BaseObject& operator[](ObjToken& token) const;
@@ -76,7 +122,7 @@ public:
 	// - 非 const 版本会在成功时用真实 token 覆盖输入 token 并返回 true（caller 可继续用该 token 访问对象）
     // TryGetRegisteration:
     // - 非 const 版本会修改 pending token，将其替换为真实 token（若已合并），并返回是否有效。
-    // - const 版本仅查询 pending->real 映射或验证已注册 token，不会修改输入。
+    // - const 版本仅检查 token 指向的槽是否已提交（或验证已注册 token），不会修改输入。
     bool TryGetRegisteration(ObjToken& token) const noexcept;
     bool TryGetRegisteration(const ObjToken& token) const noexcept;
 
@@ -88,42 +134,61 @@ public:
     // - 会调用每个对象的 OnDestroy、反注册 PhysicsSystem 并让所有 token 失效。
     void DestroyAll() noexcept;
 
+    // BeginStep: 每个逻辑步开始时、main_thread_on_update（ActSeq 等脚本移动对象）之前调用，
+    // 为所有存活对象调用 StepBeginApply() 记录上一步结束时的位置，作为渲染插值起点。
+    APPLIANCE void BeginStep() noexcept;
+
     // UpdateAll: 每帧主更新入口，顺序：
-    // 1) 为每个活跃对象调用 FrameEnterApply()（物理积分/调试绘制/记录 prev pos）
+    // 1) 为每个活跃对象调用 FrameEnterApply()（物理积分/调试绘制）
     // 2) 调用 PhysicsSystem::Step()（碰撞检测与回调）
     // 3) 为每个活跃对象调用 Update()
     // 4) 为每个活跃对象调用 FrameExitApply()
     // 5) 执行所有延迟销毁（在安全点处理，避免在遍历中删除）
-    // 6) 提交本帧 pending 创建（将 pending_creates_ 合并到 objects_ 并注册到物理系统）
+    // 6) 提交本帧 pending 创建（把 pending_creates_ 记录的预留槽标记为存活并注册到物理系统）
     //    支持 skip_update_this_frame 标志以在本帧跳过更新。
+    // 3) 只遍历 update_order_（重写了 Update 的对象，按类型分组），1)/4) 中的 StartFrame/EndFrame 按钩子掩码跳过。
     APPLIANCE void UpdateAll() noexcept;
 
     size_t Count() const noexcept { return alive_count_; }
 
     size_t GetEstimatedMemoryUsageBytes() const noexcept;
 
-    // 标签查询方法
-    // 返回所有已合并并带有指定 tag 的 ObjToken（registered tokens）
-    // FindTokensByTag: 返回第一个仍在注册列表中的、拥有指定 tag 的对象 token。
-    ObjToken FindTokensByTag(const std::string& tag) const noexcept;
+    // 标签查询方法（只返回已合并的 registered token，代价与匹配对象数量成正比，与对象总数无关）
+    // FindTokensByTag: 返回拥有指定 tag 的对象中 index 最小的一个的 token；没有时返回 Invalid。
+    // FindAllTokensByTag: 把所有拥有指定 tag 的对象 token 追加到 out（顺序不保证）。
+    // 字符串版本每次调用需一次哈希查找，热路径应缓存 TagRegistry::Intern 得到的 TagId。
+    ObjToken FindTokensByTag(TagId tag) const noexcept;
+    ObjToken FindTokensByTag(const std::string& tag) const noexcept { return FindTokensByTag(TagRegistry::Instance().Find(tag)); }
+    void FindAllTokensByTag(TagId tag, std::vector<ObjToken>& out) const;
+    void FindAllTokensByTag(const std::string& tag, std::vector<ObjToken>& out) const { FindAllTokensByTag(TagRegistry::Instance().Find(tag), out); }
 
 private:
     ObjManager() noexcept;
     ~ObjManager() noexcept;
 
     struct Entry {
-        std::unique_ptr<BaseObject> ptr;
+        ObjPtr ptr;
         uint32_t generation = 0;
+        uint32_t type_id = 0;    // 具体类型编号（与对象池编号一致），用于 Update 分组
+        uint8_t hooks = UpdateHooks::ALL;
         bool alive = false;
+        bool pending = false;    // 已由 Create 预留并持有对象，尚未在 UpdateAll 中提交（此时 alive 仍为 false）
         // 新增：创建当帧跳过 FramelyUpdate 的标志（用于合并时可能需要跳过本帧更新）
         bool skip_update_this_frame = false;
     };
 
-    // pending create 的中间结构：在 CreateEntry 时只把对象放到这里（不直接扩展 objects_），
-    // 在 UpdateAll 的提交阶段再把它们合并到 objects_（安全点，避免在更新循环中重分配）
-    struct PendingCreate {
-        std::unique_ptr<BaseObject> ptr;
-    };
+    // 每个具体类型一个池，按首次使用顺序编号；池在第一次 Create<T> 时创建，随 ObjManager 析构
+    static size_t NextPoolTypeId() noexcept { static size_t next = 0; return next++; }
+    template <typename T>
+    static size_t PoolTypeId() noexcept { static const size_t id = NextPoolTypeId(); return id; }
+    template <typename T>
+    TypedObjectPool<T>& PoolFor()
+    {
+        const size_t id = PoolTypeId<T>();
+        if (id >= pools_.size()) pools_.resize(id + 1);
+        if (!pools_[id]) pools_[id] = std::make_unique<TypedObjectPool<T>>();
+        return static_cast<TypedObjectPool<T>&>(*pools_[id]);
+    }
 
     // 为延迟创建保留 slot，并返回可用索引（复用 free_indices_ 或在尾部追加）
     uint32_t ReserveSlotForCreate() noexcept;
@@ -136,9 +201,21 @@ private:
     // DestroyExisting: 将销毁请求入队（对于已合并对象），实际删除在下一次 UpdateAll 时执行；对于 pending 对象请使用 DestroyPending。
     void DestroyExisting(const ObjToken& token) noexcept;
 
-    // 将 unique_ptr<BaseObject> 的对象纳入管理并在必要时调用 Start()，返回 PendingToken 表示创建请求。
-    // 对象会被放入 pending_creates_（带 id），在 UpdateAll 的提交阶段合并到 objects_ 并完成物理注册。
-    ObjToken CreateEntry(std::unique_ptr<BaseObject> obj);
+    // 将池中构造的对象纳入管理并在必要时调用 Start()，返回 PendingToken 表示创建请求。
+    // 对象直接放入预留槽（pending 状态）并记入 pending_creates_，在 UpdateAll 的提交阶段标记存活并完成物理注册。
+    ObjToken CreateEntry(ObjPtr obj, uint32_t type_id, uint8_t hooks);
+
+    // 按 (type_id, index) 重建 update_order_（仅在对象集合变化后的下一次 UpdateAll 执行）
+    void RebuildUpdateOrder() noexcept;
+
+    // 维护 tag_members_：提交时按对象的标签掩码登记，销毁时注销；
+    // 已注册对象运行期间的 AddTag/RemoveTag 由 BaseObject 以单个位的掩码调用
+    friend class BaseObject;
+    void LinkTags(uint32_t index, TagRegistry::Mask mask);
+    void UnlinkTags(uint32_t index, TagRegistry::Mask mask) noexcept;
+
+    // 各类型的对象池（必须先于所有持有 ObjPtr 的成员声明，使对象在池之前析构）
+    std::vector<std::unique_ptr<ObjectPoolBase>> pools_;
 
     // 存储对象条目
     std::vector<Entry> objects_;
@@ -146,6 +223,13 @@ private:
     // 空闲索引池，用于重用 slots
     std::vector<uint32_t> free_indices_;
 
+    // Update 遍历顺序：重写了 Update 的已注册对象下标，按类型分组；提交创建/销毁后标记失效
+    std::vector<uint32_t> update_order_;
+    bool update_order_dirty_ = false;
+
+    // 标签 -> 拥有该标签的已注册对象下标（外层下标为 TagId，内层无序，删除时与末尾交换）
+    std::vector<std::vector<uint32_t>> tag_members_;
+
     // BaseObject* -> index 的映射，用于快速查找（仅包含已经合并到 objects_ 的对象）
     std::unordered_map<BaseObject*, uint32_t> object_index_map_;
 
@@ -153,15 +237,8 @@ private:
     std::vector<ObjToken> pending_destroys_;
     std::unordered_set<uint64_t> pending_destroy_set_; // compact key: ((uint64_t)index<<32)|generation
 
-    // 本帧刚创建但尚未合并到 objects_ 的对象存储（pending 创建区）
-    std::unordered_map<uint32_t, PendingCreate> pending_creates_; // key = pending id
-    std::unordered_map<BaseObject*, uint32_t> pending_ptr_to_id_; // ptr -> pending id 快速查找
-
-    // pending id -> 已合并后的真实 ObjToken（合并完成后写入，便于 ResolvePending）
-    std::unordered_map<uint32_t, ObjToken> pending_to_real_map_;
-
-    // 下一个 pending id（单调递增）
-    uint32_t next_pending_id_ = 1;
+    // 本帧创建、等待提交的预留槽（按创建顺序）；提交前被 DestroyPending 的条目因 generation 不匹配而跳过
+    std::vector<ObjToken> pending_creates_;
 
     // 当前存活对象计数（包含 pending 创建）
     size_t alive_count_ = 0;
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+class BaseObject;
+
+// 类型化对象池，面向使用者说明：
+// - ObjManager 为每个具体 BaseObject 子类持有一个 TypedObjectPool<T>，对象按块（kChunkObjects 个槽）连续存放，
+//   同类对象（地砖、尖刺、血迹等）在内存中相邻，创建/销毁只在池内的空闲链表上进行，不经过通用分配器。
+// - 空闲槽以侵入式单链表串联（槽未被占用时复用其存储保存 next 指针），Release 不分配内存，可在 noexcept 路径中调用。
+// - 块只在池析构时释放：房间切换后空闲槽留给下一批同类对象复用，峰值之后不再增长。
+// 语义契约：
+// - 池只能由构造出对象的 ObjManager 通过 PooledDeleter 归还对象；Release 的参数必须是本池 Allocate 得到的 T。
+// - 非线程安全，与 ObjManager 一样只在主线程使用。
+class ObjectPoolBase {
+public:
+	virtual ~ObjectPoolBase() = default;
+
+	// 析构对象并把槽放回空闲链表
+	virtual void Release(BaseObject* obj) noexcept = 0;
+
+	virtual size_t Capacity() const noexcept = 0;
+	virtual size_t GetEstimatedMemoryUsageBytes() const noexcept = 0;
+};
+
+// unique_ptr 删除器：把对象归还给创建它的池
+struct PooledDeleter {
+	ObjectPoolBase* pool = nullptr;
+	void operator()(BaseObject* obj) const noexcept { pool->Release(obj); }
+};
+
+template <typename T>
+class TypedObjectPool final : public ObjectPoolBase {
+public:
+	static constexpr size_t kChunkObjects = 64;
+
+	TypedObjectPool() noexcept = default;
+	TypedObjectPool(const TypedObjectPool&) = delete;
+	TypedObjectPool& operator=(const TypedObjectPool&) = delete;
+
+	// 在空闲槽上原地构造 T；构造函数抛出时槽归还链表，异常继续向上传播
+	template <typename... Args>
+	T* Allocate(Args&&... args)
+	{
+		if (!free_) grow();
+		Slot* slot = free_;
+		free_ = slot->next;
+		try {
+			return ::new (static_cast<void*>(slot->storage)) T(std::forward<Args>(args)...);
+		}
+		catch (...) {
+			slot->next = free_;
+			free_ = slot;
+			throw;
+		}
+	}
+
+	void Release(BaseObject* obj) noexcept override
+	{
+		T* t = static_cast<T*>(obj);
+		t->~T();
+		Slot* slot = reinterpret_cast<Slot*>(static_cast<void*>(t));
+		slot->next = free_;
+		free_ = slot;
+	}
+
+	size_t Capacity() const noexcept override { return chunks_.size() * kChunkObjects; }
+	size_t GetEstimatedMemoryUsageBytes() const noexcept override
+	{
+		return sizeof(*this) + chunks_.capacity() * sizeof(std::unique_ptr<Slot[]>) + Capacity() * sizeof(Slot);
+	}
+
+private:
+	union Slot {
+		Slot* next;
+		alignas(T) unsigned char storage[sizeof(T)];
+	};
+
+	// 追加一个块，并按地址升序把新槽接到空闲链表头部，使连续创建的对象在内存中也连续
+	void grow()
+	{
+		std::unique_ptr<Slot[]> chunk(new Slot[kChunkObjects]);
+		for (size_t i = kChunkObjects; i-- > 0;) {
+			chunk[i].next = free_;
+			free_ = &chunk[i];
+		}
+		chunks_.push_back(std::move(chunk));
+	}
+
+	std::vector<std::unique_ptr<Slot[]>> chunks_;
+	Slot* free_ = nullptr;
+};
@@ -10,6 +10,7 @@
 #include "debug_config.h"
 #include "delegate.h"
 #include "obj_manager.h"
+#include "sprite_cache.h"
 
 extern Delegate<> main_thread_on_update;
 
@@ -54,6 +55,8 @@ public:
 		}
 		current_room_ = std::ref(const_cast<BaseRoom&>(room));
 		current_room_->get().LoadRoom();
+		// ·Ķ Create ʱ Acquire ˾飬ʱΪ 0 Ŀֻɷʹãͳһж
+		SpriteCache::Instance().TrimUnused();
 	}
 
 	// ͨƼط
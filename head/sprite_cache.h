@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+#include "cute_sprite.h" // CF_Sprite
+
+// SpriteCache 为进程级的精灵（PNG）缓存，面向使用者说明：
+// - 以资源路径为键，每个 PNG 只通过 cf_make_easy_sprite_from_png 解码一次；之后的 Acquire 直接拷贝缓存的 CF_Sprite 模板，
+//   多个对象共享同一个 easy_sprite_id（同一张纹理），因此房间加载耗时与峰值内存只随“不同资源数量”增长。
+// - 引用计数：Acquire 使计数 +1，Release 使计数 -1；计数归零时条目不会立即卸载，而是保留为“热”条目，
+//   以便房间重载（R 键重生、切换房间）时新对象可直接命中缓存。真正的卸载由 TrimUnused / Clear 完成。
+// 语义契约：
+// - 非线程安全，应在主线程的游戏循环中使用（与 ObjManager / DrawingSequence 一致）。
+// - Acquire 失败（文件不存在/解码失败）时返回 false 且不会建立条目，调用方自行回退到 cf_sprite_defaults()。
+// - 通过 Acquire 得到的 CF_Sprite 不能再调用 cf_easy_sprite_unload，必须以相同路径调用 Release 归还。
+class SpriteCache {
+public:
+    static SpriteCache& Instance() noexcept;
+
+    SpriteCache(const SpriteCache&) = delete;
+    SpriteCache& operator=(const SpriteCache&) = delete;
+
+    // 获取 path 对应的精灵：命中则直接拷贝模板，未命中则解码 PNG 并建立条目；成功时引用计数 +1
+    bool Acquire(const std::string& path, CF_Sprite& out) noexcept;
+
+    // 归还 path 对应的引用；计数归零后条目保留在缓存中，直到 TrimUnused / Clear
+    void Release(const std::string& path) noexcept;
+
+    // 卸载所有引用计数为 0 的条目，返回卸载数量（可在切换到资源差异很大的房间后调用以回收纹理）
+    size_t TrimUnused() noexcept;
+
+    // 卸载所有条目（无论引用计数），通常只在程序退出、所有对象已销毁后调用
+    void Clear() noexcept;
+
+    size_t Count() const noexcept { return entries_.size(); }
+    size_t GetEstimatedMemoryUsageBytes() const noexcept;
+
+private:
+    SpriteCache() noexcept = default;
+    ~SpriteCache() noexcept = default;
+
+    struct Entry {
+        CF_Sprite sprite{};     // 解码后的模板（只读），Acquire 时按值拷贝给调用方
+        uint32_t ref_count = 0; // 当前持有该资源的对象数量
+    };
+
+    std::unordered_map<std::string, Entry> entries_;
+};
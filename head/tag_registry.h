@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// 标签编号：由 TagRegistry 分配，0 ~ kMaxTags-1 有效
+using TagId = uint8_t;
+
+// TagRegistry 为进程级的标签字符串驻留表，面向使用者说明：
+// - Intern 把标签名映射为从 0 开始递增的小整数 TagId，同名标签始终得到同一个编号；编号在进程生命周期内不回收。
+// - 对象以 64 位掩码（Mask）保存自己的标签，HasTag 只是一次按位与；频繁查询的调用方应在初始化时 Intern 一次并缓存 TagId，
+//   避免每次调用都对字符串求哈希（例如 `static const TagId s_bullet = TagRegistry::Instance().Intern("bullet");`）。
+// 语义契约：
+// - 最多 kMaxTags 个不同标签；超出时 Intern 返回 INVALID 并输出日志，以 INVALID 调用的标签接口均为 no-op / false。
+// - 非线程安全，应在主线程使用（与 ObjManager 一致）。
+class TagRegistry {
+public:
+    using Mask = uint64_t;
+    static constexpr size_t kMaxTags = 64;
+    static constexpr TagId INVALID = 0xFF;
+
+    static TagRegistry& Instance() noexcept;
+
+    TagRegistry(const TagRegistry&) = delete;
+    TagRegistry& operator=(const TagRegistry&) = delete;
+
+    // 返回 name 的编号，首次出现时登记
+    TagId Intern(const std::string& name) noexcept;
+
+    // 只查询不登记：name 从未出现过时返回 INVALID（此时不可能有对象带有该标签）
+    TagId Find(const std::string& name) const noexcept;
+
+    // 编号对应的标签名（INVALID 或越界时返回空串），用于日志/调试
+    const std::string& Name(TagId id) const noexcept;
+
+    // 编号对应的掩码位（INVALID 时为 0）
+    static constexpr Mask Bit(TagId id) noexcept { return id < kMaxTags ? (Mask{ 1 } << id) : Mask{ 0 }; }
+
+    size_t Count() const noexcept { return names_.size(); }
+    size_t GetEstimatedMemoryUsageBytes() const noexcept;
+
+private:
+    TagRegistry() noexcept = default;
+    ~TagRegistry() noexcept = default;
+
+    std::unordered_map<std::string, TagId> ids_;
+    std::vector<std::string> names_; // 下标为 TagId
+};
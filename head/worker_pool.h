@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// WorkerPool 为常驻工作线程池，面向使用者说明：
+// - ParallelFor 把 [0, count) 切成长度为 batch 的连续区间，由工作线程与调用线程共同领取执行，返回时全部区间已完成；
+//   任务量不超过一个 batch 或线程数为 0 时直接在调用线程上串行执行，不产生任何同步开销。
+// - 区间的领取顺序不确定，调用方应让每个下标只写入自己的结果槽，再在调用线程上按下标顺序合并，以保证结果确定。
+// - 线程在 Resize/析构之间常驻并在条件变量上等待，ParallelFor 本身不分配内存。
+// 语义契约：
+// - ParallelFor 不可重入，也不可在多个线程上同时调用；fn 不得抛出异常。
+// - Emscripten 构建没有线程支持，Resize 始终保持 0 个工作线程。
+class WorkerPool {
+public:
+	WorkerPool() noexcept = default;
+	explicit WorkerPool(size_t threads) { Resize(threads); }
+	~WorkerPool() { Resize(0); }
+
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+
+	// 调整工作线程数（不含调用线程）；0 表示完全串行
+	void Resize(size_t threads);
+	size_t ThreadCount() const noexcept { return threads_.size(); }
+
+	void ParallelFor(size_t count, size_t batch, const std::function<void(size_t, size_t)>& fn);
+
+private:
+	void worker_loop(uint64_t seen); // seen：创建时的 generation_，只响应之后的 ParallelFor
+	void run_batches() noexcept;
+
+	std::vector<std::thread> threads_;
+	std::mutex mutex_;
+	std::condition_variable start_cv_;
+	std::condition_variable done_cv_;
+	uint64_t generation_ = 0;   // 每次 ParallelFor 递增，唤醒等待中的工作线程
+	size_t pending_workers_ = 0; // 本轮尚未完成的工作线程数
+	bool stop_ = false;
+
+	// 当前任务（仅在一轮 ParallelFor 期间有效）
+	const std::function<void(size_t, size_t)>* job_ = nullptr;
+	size_t job_count_ = 0;
+	size_t job_batch_ = 1;
+	std::atomic<size_t> next_{ 0 };
+};
@@ -11,6 +11,7 @@ public:
 		SpriteSetStats("/sprites/background.png", 1, 1, -1000);
 		SetPosition(cf_v2(0.0f, 0.0f));
 		SetColliderType(ColliderType::VOID);
+		SetBodyKind(BodyKind::STATIC);
 		IsColliderRotate(false);
 	}
 };
\ No newline at end of file
@@ -25,6 +25,8 @@ public:
         
         // 设置为实体碰撞类型
         SetColliderType(ColliderType::SOLID);
+        SetCollisionLayer(CollisionLayer::TERRAIN);
+        SetBodyKind(BodyKind::STATIC);
     }
 private:
 	CF_V2 target_position{ 0.0f, 0.0f };
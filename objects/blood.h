@@ -14,6 +14,8 @@ class Blood : public BaseObject {
 		SpriteSetStats("/sprites/blood.png", 1, 1, 0);
 		IsColliderRotate(false);
 		ExcludeWithSolids(true);
+		SetContinuousCollision(true); // ٶȿɴÿ֡ 6pxɨӼⱣ֤ͣڵ
+		SetCollisionLayer(CollisionLayer::DECOR, CollisionLayer::TERRAIN); // ѪֻҪײ
 		Scale(0.5f);
 	}
 	void Update() override
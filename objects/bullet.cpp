@@ -14,9 +14,12 @@ void Bullet::Start()
     // 设置子弹贴图源，其他参数使用默认值
     SpriteSetStats("/sprites/bullet.png", 2, 5, 0);
     IsColliderRotate(false);
+    SetContinuousCollision(true); // 每帧 12px 的快速小物体，避免穿过薄地形
+    SetAlwaysActive(true); // 飞出屏幕后仍需按寿命自毁，不能被激活区域冻结
 
 	// 添加标签以便后续查询
 	AddTag("bullet");
+	SetCollisionLayer(CollisionLayer::PROJECTILE, CollisionLayer::TERRAIN | CollisionLayer::TRIGGER); // 子弹只与地形、触发器碰撞
 }
 
 void Bullet::Update()
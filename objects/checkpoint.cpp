@@ -5,6 +5,8 @@ extern int g_frame_rate; // ȫ
 
 void Checkpoint::Start()
 {
+    SetBodyKind(BodyKind::STATIC);
+    SetCollisionLayer(CollisionLayer::TRIGGER, CollisionLayer::PROJECTILE); // ֻӦӵǷڸɿռѯж
     // Ѷŵλ
     SetPosition(position);
 
@@ -21,20 +23,29 @@ void Checkpoint::Start()
 		 });
 }
 
+// 浵㸽Ƿңѯÿʱ
+static const PhysicsSystem::QueryFilter s_player_filter{ TagRegistry::Instance().Intern("player") };
+static const TagId s_bullet_tag = TagRegistry::Instance().Intern("bullet");
+static std::vector<ObjManager::ObjToken> s_nearby;
+
 // ײصcheckpointӵУ򽫸 checkpoint Ϊǰļ㣨һ㣩ӵ
 void Checkpoint::OnCollisionEnter(const ObjManager::ObjToken& other, const CF_Manifold& manifold) noexcept
 {
 	auto& g_player = GlobalPlayer::Instance();
     // ֻӦ򵽴 "bullet" ǩĶ
     // ֮ԼƣЧЧȣ
-    if (!objs[other].HasTag("bullet")) return;
-	auto player = g_player.Player();
-    if (!objs.TryGetRegisteration(player)) return;
+    if (!objs[other].HasTag(s_bullet_tag)) return;
+    // Ҫվڴ浵㸽45 ڣ
+    s_nearby.clear();
+    PhysicsSystem::Instance().QueryCircle(GetPosition(), 45.0f, s_nearby, s_player_filter);
+    // ѯײصغѡԭ㵽浵ľж
     auto pos = GetPosition();
-	auto player_pos = objs[player].GetPosition();
-    if (v2math::length(pos - player_pos) <= 45.0f) {
-        g_player.SetRespawnPoint(GetPosition() + CF_V2(0, SpriteHeight()/2.0f));
-		turning_green.play(this);
+    for (const auto& token : s_nearby) {
+        if (v2math::length(pos - objs[token].GetPosition()) <= 45.0f) {
+            g_player.SetRespawnPoint(pos + CF_V2(0, SpriteHeight()/2.0f));
+            turning_green.play(this);
+            break;
+        }
     }
 }
 
@@ -21,6 +21,8 @@ public:
 
         // Ϊʵײ
         SetColliderType(ColliderType::SOLID);
+        SetCollisionLayer(CollisionLayer::TERRAIN);
+        SetBodyKind(BodyKind::STATIC);
     }
 private:
     CF_V2 target_position{ 0.0f, 0.0f };
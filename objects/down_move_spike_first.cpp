@@ -4,6 +4,7 @@
 extern int g_frame_rate; // ȫ֡ʣÿ֡
 
 void FirstDownMoveSpike::Start() {
+    SetBodyKind(BodyKind::KINEMATIC);
 
 	//ת̵ķ
 	SpriteFlipY(true);
@@ -45,20 +46,27 @@ void FirstDownMoveSpike::Start() {
 	);
 }
 
-void FirstDownMoveSpike::Update() {
-
-	//ȡλ
-	auto& player = GlobalPlayer::Instance().Player();
-	if (!objs.TryGetRegisteration(player)) return;
-
-	CF_V2 pos = objs[player].GetPosition();
+// Ƿңѯÿ֡
+static const PhysicsSystem::QueryFilter s_player_filter{ TagRegistry::Instance().Intern("player") };
+static std::vector<ObjManager::ObjToken> s_overlaps;
 
-	float min_x = 396.0f;
-	float max_x = 432.0f;
-	float min_y = -396.0f;
-	float max_y = -288.0f;
+void FirstDownMoveSpike::Update() {
 
-	if (inside(pos, min_x, max_x, min_y, max_y)) {
+	CF_Aabb region;
+	region.min = cf_v2(396.0f, -396.0f);
+	region.max = cf_v2(432.0f, -288.0f);
+
+	s_overlaps.clear();
+	PhysicsSystem::Instance().QueryAabb(region, s_overlaps, s_player_filter);
+	// ѯײصغѡԭΪ׼
+	bool triggered = false;
+	for (const auto& token : s_overlaps) {
+		if (inside(objs[token].GetPosition(), region.min.x, region.max.x, region.min.y, region.max.y)) {
+			triggered = true;
+			break;
+		}
+	}
+	if (triggered) {
 		// Ŷ
 		if(!m_act_seq.is_playing()) m_act_seq.play(this);
 	}
@@ -3,6 +3,7 @@
 
 void DownSpike::Start()
 {
+    SetBodyKind(BodyKind::STATIC);
     //ת̵ķ
     SpriteFlipY(true);
     SpriteSetSource("/sprites/Obj_Spike.png", 1);
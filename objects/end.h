@@ -11,6 +11,7 @@ public:
 		SpriteSetSource("/sprites/end.png", 1);
 		SetPosition(cf_v2(0.0f, 0.0f));
 		SetColliderType(ColliderType::VOID);
+		SetBodyKind(BodyKind::STATIC);
 		IsColliderRotate(false);
 	}
 };
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 void HiddenBlock::Start()
 {
+    SetBodyKind(BodyKind::STATIC);
     // þ
 
     SpriteSetSource("/sprites/transparent_block_.png", 1);
@@ -17,6 +18,7 @@ void HiddenBlock::Start()
 
     // Ϊʵײ
     SetColliderType(ColliderType::SOLID);
+    SetCollisionLayer(CollisionLayer::TERRAIN);
 }
 
 static auto& g = GlobalPlayer::Instance();
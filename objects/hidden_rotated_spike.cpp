@@ -7,6 +7,7 @@ extern int g_frame_rate; // 全局帧率，每秒帧数
 
 void HiddenRotatedSpike::Start()
 {
+    SetBodyKind(BodyKind::KINEMATIC);
     // 设置默认精灵资源
     SpriteSetSource("/sprites/Obj_Spike.png", 1);
 	SetDepth(-10); // 确保刺被方块遮挡
@@ -62,19 +63,34 @@ void HiddenRotatedSpike::Start()
 static auto& g = GlobalPlayer::Instance();
 const float hh = 18.0f;
 
+// 触发检测：只关心带 "player" 标签的对象；查询结果复用容量，避免每帧分配
+static const PhysicsSystem::QueryFilter s_player_filter{ TagRegistry::Instance().Intern("player") };
+static std::vector<ObjManager::ObjToken> s_overlaps;
+
 void HiddenRotatedSpike::Update()
 {
-	auto player = g.Player();
-    if (!objs.TryGetRegisteration(g.Player())) return;
-    CF_V2 player_pos = objs[player].GetPosition();
+    if (!once) return;
+
+    // 触发区域：刺所在行、朝刺尖方向延伸 check_count + 1 格的矩形
     int dir = direction_left ? 1.0f : -1.0f;
-    if (once
-        && position.y - player_pos.y < hh
-        && player_pos.y - position.y < hh
-        && (player_pos.x - position.x) * dir < 0.0f
-        && (position.x - player_pos.x) * dir < 2 * hh * (check_count + 1)) {
-        once = false;
-        m_act_seq.play(this);
+    float reach = 2 * hh * (check_count + 1);
+    CF_Aabb region;
+    region.min = cf_v2(dir > 0 ? position.x - reach : position.x, position.y - hh);
+    region.max = cf_v2(dir > 0 ? position.x : position.x + reach, position.y + hh);
+
+    s_overlaps.clear();
+    PhysicsSystem::Instance().QueryAabb(region, s_overlaps, s_player_filter);
+    // 查询按碰撞体重叠返回候选，触发时机仍以玩家原点落入区域为准（与查询化之前一致）
+    for (const auto& token : s_overlaps) {
+        CF_V2 player_pos = objs[token].GetPosition();
+        if (position.y - player_pos.y < hh
+            && player_pos.y - position.y < hh
+            && (player_pos.x - position.x) * dir < 0.0f
+            && (position.x - player_pos.x) * dir < reach) {
+            once = false;
+            m_act_seq.play(this);
+            break;
+        }
     }
 }
 
@@ -7,6 +7,7 @@ extern int g_frame_rate; // 全局帧率，每秒帧数
 
 void HiddenSpike::Start()
 {
+    SetBodyKind(BodyKind::KINEMATIC);
     // 设置默认精灵资源
     SpriteSetSource("/sprites/Obj_Spike.png", 1);
 	SetDepth(-10); // 确保刺被方块遮挡
@@ -61,19 +62,34 @@ void HiddenSpike::Start()
 static auto& g = GlobalPlayer::Instance();
 const float hw = 18.0f;
 
+// 触发检测：只关心带 "player" 标签的对象；查询结果复用容量，避免每帧分配
+static const PhysicsSystem::QueryFilter s_player_filter{ TagRegistry::Instance().Intern("player") };
+static std::vector<ObjManager::ObjToken> s_overlaps;
+
 void HiddenSpike::Update()
 {
-	auto player = g.Player();
-    if (!objs.TryGetRegisteration(g.Player())) return;
-    CF_V2 player_pos = objs[player].GetPosition();
+    if (!once) return;
+
+    // 触发区域：刺所在列、朝刺尖方向延伸 check_count + 1 格的矩形，交给物理系统做区域查询
     int dir = direction_up ? 1.0f : -1.0f;
-    if (once
-        && position.x - player_pos.x < hw
-        && player_pos.x - position.x < hw
-        && (position.y - player_pos.y) * dir < 0.0f
-        && (player_pos.y - position.y) * dir < 2 * hw * (check_count + 1)) {
-        once = false;
-        m_act_seq.play(this);
+    float reach = 2 * hw * (check_count + 1);
+    CF_Aabb region;
+    region.min = cf_v2(position.x - hw, dir > 0 ? position.y : position.y - reach);
+    region.max = cf_v2(position.x + hw, dir > 0 ? position.y + reach : position.y);
+
+    s_overlaps.clear();
+    PhysicsSystem::Instance().QueryAabb(region, s_overlaps, s_player_filter);
+    // 查询按碰撞体重叠返回候选，触发时机仍以玩家原点落入区域为准（与查询化之前一致）
+    for (const auto& token : s_overlaps) {
+        CF_V2 player_pos = objs[token].GetPosition();
+        if (position.x - player_pos.x < hw
+            && player_pos.x - position.x < hw
+            && (position.y - player_pos.y) * dir < 0.0f
+            && (player_pos.y - position.y) * dir < reach) {
+            once = false;
+            m_act_seq.play(this);
+            break;
+        }
     }
 }
 
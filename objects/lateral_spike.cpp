@@ -3,6 +3,7 @@
 
 void LeftLateralSpike::Start()
 {
+    SetBodyKind(BodyKind::STATIC);
     const double pi = 3.14159265358979323846;
 
     //ת̵ķ
@@ -22,6 +23,7 @@ void LeftLateralSpike::Start()
 
 void RightLateralSpike::Start()
 {
+    SetBodyKind(BodyKind::STATIC);
     const double pi = 3.14159265358979323846;
 
     //ת̵ķ
@@ -6,6 +6,7 @@
 extern int g_frame_rate;
 
 void LeftMoveBlock::Start() {
+    SetBodyKind(BodyKind::KINEMATIC);
     //ͼƬ
     SpriteSetStats("/sprites/block1.png", 1, 1, 0);
     SetPosition(initial_position);
@@ -19,6 +20,7 @@ void LeftMoveBlock::Start() {
 
     SetCenteredAabb(hw, hh);
     SetColliderType(ColliderType::SOLID);
+    SetCollisionLayer(CollisionLayer::TERRAIN);
 
 
     float move_distance = 260.0f;
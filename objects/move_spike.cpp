@@ -3,6 +3,7 @@
 extern int g_frame_rate; // ȫ֡ʣÿ֡
 
 void MoveSpike::Start() {
+	SetBodyKind(BodyKind::KINEMATIC);
 	// þԴʼ״̬
 	SpriteSetStats("/sprites/Obj_Spike.png", 1, 1, 0);
 	SetPosition(cf_v2(300.0f, 0.0f)); // ʼλ
@@ -17,10 +17,14 @@ static constexpr float jump_buffer_window = 0.1f; // 跳跃预输入窗口（秒
 
 void PlayerObject::Start()
 {
-    // 统一设置贴图路径、竖排帧数、动画更新频率和绘制深度，并注册到绘制序列
-    // 如需要默认值，请使用高粒度的 SetSprite*() 和 Set*() 方法逐一设置非默认值参数
-    // 资源路径无默认值，必须手动设置
-    SpriteSetStats("/sprites/idle.png", 3, 6, 0);
+    // 预加载各状态的动画片段（竖排帧数、动画更新频率），之后在 EndFrame 中按索引切换，不再重复加载 PNG
+    clip_idle = SpriteAddClip("idle", "/sprites/idle.png", 3, 6);
+    clip_walk = SpriteAddClip("walk", "/sprites/walk.png", 2, 5);
+    clip_jump = SpriteAddClip("jump", "/sprites/jump.png", 2, 4);
+    clip_fall = SpriteAddClip("fall", "/sprites/fall.png", 2, 4);
+    // 首次播放片段时注册到绘制序列
+    SpritePlayClip(clip_idle);
+    SetDepth(0);
 
 
     // 可选：初始化位置（根据需要调整），例如屏幕中心附近
@@ -28,9 +32,11 @@ void PlayerObject::Start()
 
     Scale(0.5f);
 	AddTag("player");
+	SetCollisionLayer(CollisionLayer::PLAYER);
 	ExcludeWithSolids(true);
     SetCenteredAabb(18.0f, SpriteHeight() / 2); // 设置以贴图中心为基准的碰撞 AABB
     IsColliderRotate(false);
+	SetAlwaysActive(true); // 离开屏幕时仍需更新（房间切换 / 死亡判定）
 
 	// 初始化跳跃状态
 	double_jump_ready = true;
@@ -120,22 +126,12 @@ void PlayerObject::EndFrame() {
     auto vel = GetVelocity();
     if (vel.x != 0) SpriteFlipX(vel.x < 0);
 
-    // 根据状态切换贴图
+    // 根据状态切换动画片段（按索引切换，状态未变化时为空操作）
     if (grounded) {
-        if (vel.x != 0) {
-            SpriteSetStats("/sprites/walk.png", 2, 5, 0, false);
-        }
-        else {
-            SpriteSetStats("/sprites/idle.png", 3, 6, 0, false);
-        }
+        SpritePlayClip(vel.x != 0 ? clip_walk : clip_idle);
     }
     else {
-        if (vel.y > 0) {
-            SpriteSetStats("/sprites/jump.png", 2, 4, 0, false);
-        }
-        else {
-            SpriteSetStats("/sprites/fall.png", 2, 4, 0, false);
-        }
+        SpritePlayClip(vel.y > 0 ? clip_jump : clip_fall);
     }
 }
 
@@ -21,6 +21,11 @@ private:
 	bool grounded = false;
 	bool double_jump_ready = true;
 	float jump_input_timer = 0.0f;
+	// 在 Start() 中预加载的动画片段索引
+	int clip_idle = -1;
+	int clip_walk = -1;
+	int clip_jump = -1;
+	int clip_fall = -1;
 	// 记录上一个checkpoint（或默认复活点) 的位置，用于玩家复活/传送使用
 	// -当前向量为默认位置：
 	CF_V2 respawn_point;
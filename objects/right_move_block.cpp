@@ -6,6 +6,7 @@
 extern int g_frame_rate;
 
 void RightMoveBlock::Start() {
+   SetBodyKind(BodyKind::KINEMATIC);
    //图片设置
     SpriteSetStats("/sprites/block1.png", 1, 1, 0);
     SetPosition(initial_position);
@@ -18,6 +19,7 @@ void RightMoveBlock::Start() {
 
     SetCenteredAabb(hw, hh);
     SetColliderType(ColliderType::SOLID);
+    SetCollisionLayer(CollisionLayer::TERRAIN);
 
     float move_distance = 260.0f;
     float move_speed = 1.7f;
@@ -4,6 +4,7 @@
 extern int g_frame_rate; // ȫ֡ʣÿ֡
 
 void RotateSpike::Start() {
+    SetBodyKind(BodyKind::KINEMATIC);
 
 	// þԴʼ״̬
 	SpriteSetStats("/sprites/Obj_Spike.png", 1, 1, 0);
@@ -3,6 +3,7 @@
 
 void Spike::Start()
 {
+    SetBodyKind(BodyKind::STATIC);
     // 设置默认精灵资源
     SpriteSetSource("/sprites/Obj_Spike.png", 1);
 
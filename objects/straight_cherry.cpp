@@ -6,6 +6,7 @@
 extern int g_frame_rate; // 全局帧率，每秒帧数
 
 void StraightCherry::Start() {
+    SetBodyKind(BodyKind::KINEMATIC);
     // 设置精灵资源和初始状态
     CF_V2 pos = initial_position;
     SpriteSetStats("/sprites/Obj_Cherry.png", 1, 1, 0);
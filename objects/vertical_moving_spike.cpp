@@ -6,6 +6,7 @@
 extern int g_frame_rate;
 
 void VerticalMovingSpike::Start() {
+    SetBodyKind(BodyKind::KINEMATIC);
     // Set sprite and initial state
     SpriteSetStats("/sprites/Obj_Spike.png", 1, 1, 0);
     SetPosition(initial_position);
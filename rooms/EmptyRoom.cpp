@@ -150,6 +150,9 @@ public:
 	void RoomLoad() override {
 		OUTPUT({ "EmptyRoom" }, "RoomLoad called.");
 
+		// 本房间由成排的方块与刺组成，沿 x 轴扫描比均匀网格产生的候选对更少
+		PhysicsSystem::Instance().SetBroadphaseMode(BroadphaseMode::SWEEP_AND_PRUNE);
+
 		auto& objs = ObjManager::Instance();
 		auto& g_player = GlobalPlayer::Instance();
 
@@ -364,6 +367,7 @@ public:
 	}
 	void RoomUnload() override {
 		OUTPUT({ "TestRoom" }, "RoomUnload called.");
+		PhysicsSystem::Instance().SetBroadphaseMode(BroadphaseMode::GRID);
 	}
 };
 
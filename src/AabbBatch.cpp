@@ -0,0 +1,80 @@
+#include "aabb_batch.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define AABB_BATCH_WIDTH 8
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AABB_BATCH_WIDTH 4
+#else
+#define AABB_BATCH_WIDTH 1
+#endif
+
+void AabbPairBatch::Clear() noexcept
+{
+	ax0_.clear(); ay0_.clear(); ax1_.clear(); ay1_.clear();
+	bx0_.clear(); by0_.clear(); bx1_.clear(); by1_.clear();
+}
+
+void AabbPairBatch::Reserve(size_t count)
+{
+	ax0_.reserve(count); ay0_.reserve(count); ax1_.reserve(count); ay1_.reserve(count);
+	bx0_.reserve(count); by0_.reserve(count); bx1_.reserve(count); by1_.reserve(count);
+}
+
+void AabbPairBatch::Push(const CF_Aabb& a, const CF_Aabb& b)
+{
+	ax0_.push_back(a.min.x); ay0_.push_back(a.min.y); ax1_.push_back(a.max.x); ay1_.push_back(a.max.y);
+	bx0_.push_back(b.min.x); by0_.push_back(b.min.y); bx1_.push_back(b.max.x); by1_.push_back(b.max.y);
+}
+
+size_t AabbPairBatch::TestOverlap(std::vector<uint8_t>& keep) const
+{
+	const size_t n = Size();
+	keep.resize(n);
+	size_t survivors = 0;
+	size_t i = 0;
+
+#if AABB_BATCH_WIDTH == 8
+	for (; i + 8 <= n; i += 8) {
+		__m256 m = _mm256_cmp_ps(_mm256_loadu_ps(&ax0_[i]), _mm256_loadu_ps(&bx1_[i]), _CMP_LE_OQ);
+		m = _mm256_and_ps(m, _mm256_cmp_ps(_mm256_loadu_ps(&bx0_[i]), _mm256_loadu_ps(&ax1_[i]), _CMP_LE_OQ));
+		m = _mm256_and_ps(m, _mm256_cmp_ps(_mm256_loadu_ps(&ay0_[i]), _mm256_loadu_ps(&by1_[i]), _CMP_LE_OQ));
+		m = _mm256_and_ps(m, _mm256_cmp_ps(_mm256_loadu_ps(&by0_[i]), _mm256_loadu_ps(&ay1_[i]), _CMP_LE_OQ));
+		const int bits = _mm256_movemask_ps(m);
+		for (int k = 0; k < 8; ++k) {
+			const uint8_t hit = static_cast<uint8_t>((bits >> k) & 1);
+			keep[i + k] = hit;
+			survivors += hit;
+		}
+	}
+#elif AABB_BATCH_WIDTH == 4
+	for (; i + 4 <= n; i += 4) {
+		__m128 m = _mm_cmple_ps(_mm_loadu_ps(&ax0_[i]), _mm_loadu_ps(&bx1_[i]));
+		m = _mm_and_ps(m, _mm_cmple_ps(_mm_loadu_ps(&bx0_[i]), _mm_loadu_ps(&ax1_[i])));
+		m = _mm_and_ps(m, _mm_cmple_ps(_mm_loadu_ps(&ay0_[i]), _mm_loadu_ps(&by1_[i])));
+		m = _mm_and_ps(m, _mm_cmple_ps(_mm_loadu_ps(&by0_[i]), _mm_loadu_ps(&ay1_[i])));
+		const int bits = _mm_movemask_ps(m);
+		for (int k = 0; k < 4; ++k) {
+			const uint8_t hit = static_cast<uint8_t>((bits >> k) & 1);
+			keep[i + k] = hit;
+			survivors += hit;
+		}
+	}
+#endif
+
+	// 尾部（以及无 SIMD 的平台）逐对处理；使用按位与避免分支
+	for (; i < n; ++i) {
+		const uint8_t hit = static_cast<uint8_t>((ax0_[i] <= bx1_[i]) & (bx0_[i] <= ax1_[i])
+			& (ay0_[i] <= by1_[i]) & (by0_[i] <= ay1_[i]));
+		keep[i] = hit;
+		survivors += hit;
+	}
+	return survivors;
+}
+
+size_t AabbPairBatch::GetEstimatedMemoryUsageBytes() const noexcept
+{
+	return (ax0_.capacity() + ay0_.capacity() + ax1_.capacity() + ay1_.capacity()
+		+ bx0_.capacity() + by0_.capacity() + bx1_.capacity() + by1_.capacity()) * sizeof(float);
+}
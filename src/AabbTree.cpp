@@ -0,0 +1,247 @@
+#include "aabb_tree.h"
+#include <algorithm>
+#include <cmath>
+
+// 胖 AABB 沿位移方向的预测倍数：快速移动的对象预留更大的余量，减少下一帧的重插
+static constexpr float DISPLACEMENT_MULTIPLIER = 4.0f;
+
+int32_t AabbTree::allocate_node()
+{
+	if (free_list_ == NULL_NODE) {
+		nodes_.emplace_back();
+		nodes_.back().height = 0;
+		return static_cast<int32_t>(nodes_.size() - 1);
+	}
+	int32_t id = free_list_;
+	free_list_ = nodes_[id].parent;
+	nodes_[id] = Node{};
+	nodes_[id].height = 0;
+	return id;
+}
+
+void AabbTree::free_node(int32_t id) noexcept
+{
+	nodes_[id].parent = free_list_;
+	nodes_[id].child1 = NULL_NODE;
+	nodes_[id].child2 = NULL_NODE;
+	nodes_[id].height = -1;
+	free_list_ = id;
+}
+
+int32_t AabbTree::CreateProxy(const CF_Aabb& aabb, uint32_t user_data, float margin)
+{
+	int32_t id = allocate_node();
+	Node& n = nodes_[id];
+	n.aabb.min = cf_v2(aabb.min.x - margin, aabb.min.y - margin);
+	n.aabb.max = cf_v2(aabb.max.x + margin, aabb.max.y + margin);
+	n.user_data = user_data;
+	insert_leaf(id);
+	++proxy_count_;
+	return id;
+}
+
+void AabbTree::DestroyProxy(int32_t proxy) noexcept
+{
+	remove_leaf(proxy);
+	free_node(proxy);
+	--proxy_count_;
+}
+
+bool AabbTree::MoveProxy(int32_t proxy, const CF_Aabb& aabb, CF_V2 displacement, float margin)
+{
+	if (contains(nodes_[proxy].aabb, aabb)) return false;
+
+	remove_leaf(proxy);
+
+	CF_Aabb fat;
+	fat.min = cf_v2(aabb.min.x - margin, aabb.min.y - margin);
+	fat.max = cf_v2(aabb.max.x + margin, aabb.max.y + margin);
+	const float dx = DISPLACEMENT_MULTIPLIER * displacement.x;
+	const float dy = DISPLACEMENT_MULTIPLIER * displacement.y;
+	if (dx < 0.0f) fat.min.x += dx; else fat.max.x += dx;
+	if (dy < 0.0f) fat.min.y += dy; else fat.max.y += dy;
+	nodes_[proxy].aabb = fat;
+
+	insert_leaf(proxy);
+	return true;
+}
+
+// 自顶向下选择兄弟节点：比较“直接与当前节点成为兄弟”与“继续下降到某个孩子”的周长代价（继承代价为沿途祖先的周长增量）
+void AabbTree::insert_leaf(int32_t leaf) noexcept
+{
+	if (root_ == NULL_NODE) {
+		root_ = leaf;
+		nodes_[leaf].parent = NULL_NODE;
+		return;
+	}
+
+	const CF_Aabb leaf_aabb = nodes_[leaf].aabb;
+	int32_t index = root_;
+	while (!nodes_[index].is_leaf()) {
+		const int32_t c1 = nodes_[index].child1;
+		const int32_t c2 = nodes_[index].child2;
+
+		const float area = perimeter(nodes_[index].aabb);
+		const float combined_area = perimeter(combine(nodes_[index].aabb, leaf_aabb));
+		const float cost = 2.0f * combined_area;
+		const float inheritance_cost = 2.0f * (combined_area - area);
+
+		auto descend_cost = [&](int32_t child) {
+			const CF_Aabb merged = combine(leaf_aabb, nodes_[child].aabb);
+			if (nodes_[child].is_leaf()) return perimeter(merged) + inheritance_cost;
+			return perimeter(merged) - perimeter(nodes_[child].aabb) + inheritance_cost;
+		};
+		const float cost1 = descend_cost(c1);
+		const float cost2 = descend_cost(c2);
+
+		if (cost < cost1 && cost < cost2) break;
+		index = cost1 < cost2 ? c1 : c2;
+	}
+
+	// 新建父节点，sibling 与 leaf 成为其孩子
+	const int32_t sibling = index;
+	const int32_t old_parent = nodes_[sibling].parent;
+	const int32_t new_parent = allocate_node();
+	nodes_[new_parent].parent = old_parent;
+	nodes_[new_parent].aabb = combine(leaf_aabb, nodes_[sibling].aabb);
+	nodes_[new_parent].height = nodes_[sibling].height + 1;
+	nodes_[new_parent].child1 = sibling;
+	nodes_[new_parent].child2 = leaf;
+	nodes_[sibling].parent = new_parent;
+	nodes_[leaf].parent = new_parent;
+
+	if (old_parent != NULL_NODE) {
+		if (nodes_[old_parent].child1 == sibling) nodes_[old_parent].child1 = new_parent;
+		else nodes_[old_parent].child2 = new_parent;
+	}
+	else {
+		root_ = new_parent;
+	}
+
+	// 向上修正高度与包围盒，并做旋转平衡
+	index = nodes_[leaf].parent;
+	while (index != NULL_NODE) {
+		index = balance(index);
+		const int32_t c1 = nodes_[index].child1;
+		const int32_t c2 = nodes_[index].child2;
+		nodes_[index].height = 1 + std::max(nodes_[c1].height, nodes_[c2].height);
+		nodes_[index].aabb = combine(nodes_[c1].aabb, nodes_[c2].aabb);
+		index = nodes_[index].parent;
+	}
+}
+
+void AabbTree::remove_leaf(int32_t leaf) noexcept
+{
+	if (leaf == root_) {
+		root_ = NULL_NODE;
+		return;
+	}
+
+	const int32_t parent = nodes_[leaf].parent;
+	const int32_t grand_parent = nodes_[parent].parent;
+	const int32_t sibling = nodes_[parent].child1 == leaf ? nodes_[parent].child2 : nodes_[parent].child1;
+
+	if (grand_parent == NULL_NODE) {
+		root_ = sibling;
+		nodes_[sibling].parent = NULL_NODE;
+		free_node(parent);
+		return;
+	}
+
+	// 用 sibling 顶替 parent 的位置，再向上修正
+	if (nodes_[grand_parent].child1 == parent) nodes_[grand_parent].child1 = sibling;
+	else nodes_[grand_parent].child2 = sibling;
+	nodes_[sibling].parent = grand_parent;
+	free_node(parent);
+
+	int32_t index = grand_parent;
+	while (index != NULL_NODE) {
+		index = balance(index);
+		const int32_t c1 = nodes_[index].child1;
+		const int32_t c2 = nodes_[index].child2;
+		nodes_[index].aabb = combine(nodes_[c1].aabb, nodes_[c2].aabb);
+		nodes_[index].height = 1 + std::max(nodes_[c1].height, nodes_[c2].height);
+		index = nodes_[index].parent;
+	}
+}
+
+// 若 a 的两棵子树高度差超过 1，则把较高的孩子旋转上来；返回旋转后该位置的子树根
+int32_t AabbTree::balance(int32_t a) noexcept
+{
+	Node& A = nodes_[a];
+	if (A.is_leaf() || A.height < 2) return a;
+
+	const int32_t b = A.child1;
+	const int32_t c = A.child2;
+	const int32_t diff = nodes_[c].height - nodes_[b].height;
+	if (diff >= -1 && diff <= 1) return a;
+
+	// 较高的孩子 up 上移到 a 的位置，a 成为 up 的孩子，up 的较高孙子留在 up 之下
+	const int32_t up = diff > 0 ? c : b;
+	const int32_t low = diff > 0 ? b : c;
+	Node& U = nodes_[up];
+	const int32_t f = U.child1;
+	const int32_t g = U.child2;
+
+	U.child1 = a;
+	U.parent = A.parent;
+	A.parent = up;
+
+	if (U.parent != NULL_NODE) {
+		if (nodes_[U.parent].child1 == a) nodes_[U.parent].child1 = up;
+		else nodes_[U.parent].child2 = up;
+	}
+	else {
+		root_ = up;
+	}
+
+	const bool keep_f = nodes_[f].height > nodes_[g].height;
+	const int32_t keep = keep_f ? f : g;
+	const int32_t give = keep_f ? g : f;
+	U.child2 = keep;
+	if (diff > 0) A.child2 = give; else A.child1 = give;
+	nodes_[give].parent = a;
+
+	A.aabb = combine(nodes_[low].aabb, nodes_[give].aabb);
+	A.height = 1 + std::max(nodes_[low].height, nodes_[give].height);
+	U.aabb = combine(A.aabb, nodes_[keep].aabb);
+	U.height = 1 + std::max(A.height, nodes_[keep].height);
+	return up;
+}
+
+bool AabbTree::segment_overlaps(const CF_Aabb& box, CF_V2 origin, CF_V2 dir, float max_t) noexcept
+{
+	float t0 = 0.0f;
+	float t1 = max_t;
+	const float o[2] = { origin.x, origin.y };
+	const float d[2] = { dir.x, dir.y };
+	const float lo[2] = { box.min.x, box.min.y };
+	const float hi[2] = { box.max.x, box.max.y };
+	for (int axis = 0; axis < 2; ++axis) {
+		if (std::fabs(d[axis]) < 1e-12f) {
+			if (o[axis] < lo[axis] || o[axis] > hi[axis]) return false;
+			continue;
+		}
+		const float inv = 1.0f / d[axis];
+		float ta = (lo[axis] - o[axis]) * inv;
+		float tb = (hi[axis] - o[axis]) * inv;
+		if (ta > tb) std::swap(ta, tb);
+		t0 = std::max(t0, ta);
+		t1 = std::min(t1, tb);
+		if (t0 > t1) return false;
+	}
+	return true;
+}
+
+void AabbTree::Clear() noexcept
+{
+	nodes_.clear();
+	root_ = NULL_NODE;
+	free_list_ = NULL_NODE;
+	proxy_count_ = 0;
+}
+
+size_t AabbTree::GetEstimatedMemoryUsageBytes() const noexcept
+{
+	return nodes_.capacity() * sizeof(Node) + stack_.capacity() * sizeof(int32_t);
+}
@@ -0,0 +1,421 @@
+#include "broadphase.h"
+#include <algorithm>
+#include <cmath>
+
+static bool overlap_aabb(const CF_Aabb& a, const CF_Aabb& b) noexcept
+{
+	return a.min.x <= b.max.x && b.min.x <= a.max.x && a.min.y <= b.max.y && b.min.y <= a.max.y;
+}
+
+void Broadphase::QueryRay(CF_V2 origin, CF_V2 dir, float max_t, std::vector<uint32_t>& out) const
+{
+	CF_V2 end = cf_v2(origin.x + dir.x * max_t, origin.y + dir.y * max_t);
+	CF_Aabb box;
+	box.min = cf_v2(std::min(origin.x, end.x), std::min(origin.y, end.y));
+	box.max = cf_v2(std::max(origin.x, end.x), std::max(origin.y, end.y));
+	QueryAabb(box, out);
+}
+
+//--------------------------GridBroadphase--------------------------
+
+GridBroadphase::CellRange GridBroadphase::to_range(const CF_Aabb& aabb) const noexcept
+{
+	CellRange r;
+	r.gx0 = static_cast<int32_t>(std::floor(aabb.min.x / cell_size_));
+	r.gy0 = static_cast<int32_t>(std::floor(aabb.min.y / cell_size_));
+	r.gx1 = static_cast<int32_t>(std::floor(aabb.max.x / cell_size_));
+	r.gy1 = static_cast<int32_t>(std::floor(aabb.max.y / cell_size_));
+	return r;
+}
+
+void GridBroadphase::SetCellSize(float cell_size) noexcept
+{
+	if (cell_size <= 0.0f || cell_size == cell_size_) return;
+	cell_size_ = cell_size;
+	rebuild_static();
+}
+
+void GridBroadphase::SetStatic(const std::vector<CF_Aabb>& aabbs, const std::vector<uint8_t>& flags,
+	const std::vector<CollisionFilter>& filters)
+{
+	static_aabbs_ = aabbs;
+	static_flags_ = flags;
+	static_filters_ = filters;
+	rebuild_static();
+}
+
+void GridBroadphase::rebuild_static() noexcept
+{
+	static_ranges_.resize(static_aabbs_.size());
+	static_grid_.Begin(static_aabbs_.size());
+	for (size_t i = 0; i < static_aabbs_.size(); ++i) {
+		if (!(static_flags_[i] & BroadphaseFlag::ACTIVE)) {
+			static_ranges_[i] = CellRange{};
+			continue;
+		}
+		static_ranges_[i] = to_range(static_aabbs_[i]);
+		const CellRange& r = static_ranges_[i];
+		for (int32_t gx = r.gx0; gx <= r.gx1; ++gx) {
+			for (int32_t gy = r.gy0; gy <= r.gy1; ++gy) {
+				static_grid_.Add(gx, gy, static_cast<uint32_t>(i));
+			}
+		}
+	}
+	static_grid_.Finalize();
+}
+
+// 对每个活跃运动条目遍历其 AABB 覆盖的所有格子：
+// - 运动网格中下标更大的条目产生运动-运动候选对（保证 a < b）
+// - 需要与静态配对的条目再查询静态网格
+// 碰撞层互不接受的对在此直接丢弃；跨越多个共享格子的同一对只在两者格子范围交集的左下角格子产生一次
+void GridBroadphase::CollectPairs(const std::vector<CF_Aabb>& aabbs, const std::vector<uint8_t>& flags,
+	const std::vector<CollisionFilter>& filters, std::vector<BroadphasePair>& out)
+{
+	moving_ranges_.resize(aabbs.size());
+	size_t refs = 0;
+	for (size_t i = 0; i < aabbs.size(); ++i) {
+		if (!(flags[i] & BroadphaseFlag::ACTIVE)) {
+			moving_ranges_[i] = CellRange{};
+			continue;
+		}
+		moving_ranges_[i] = to_range(aabbs[i]);
+		const CellRange& r = moving_ranges_[i];
+		refs += static_cast<size_t>(r.gx1 - r.gx0 + 1) * static_cast<size_t>(r.gy1 - r.gy0 + 1);
+	}
+
+	moving_grid_.Begin(refs);
+	for (size_t i = 0; i < aabbs.size(); ++i) {
+		const CellRange& r = moving_ranges_[i];
+		for (int32_t gx = r.gx0; gx <= r.gx1; ++gx) {
+			for (int32_t gy = r.gy0; gy <= r.gy1; ++gy) {
+				moving_grid_.Add(gx, gy, static_cast<uint32_t>(i));
+			}
+		}
+	}
+	moving_grid_.Finalize();
+
+	// 当前格子是否为两个范围交集的第一个格子（两者在其它共享格子中同样会相遇，只在这里输出）
+	auto first_shared_cell = [](const CellRange& r, const CellRange& o, int32_t gx, int32_t gy) noexcept {
+		return gx == std::max(r.gx0, o.gx0) && gy == std::max(r.gy0, o.gy0);
+	};
+
+	last_duplicates_skipped_ = 0;
+	for (size_t i = 0; i < aabbs.size(); ++i) {
+		const CellRange& r = moving_ranges_[i];
+		const bool query_static = (flags[i] & BroadphaseFlag::QUERY_STATIC) != 0;
+		const uint32_t a = static_cast<uint32_t>(i);
+		for (int32_t gx = r.gx0; gx <= r.gx1; ++gx) {
+			for (int32_t gy = r.gy0; gy <= r.gy1; ++gy) {
+				for (uint32_t j : moving_grid_.Query(gx, gy)) {
+					if (j <= a || !filters[a].Accepts(filters[j])) continue;
+					if (!first_shared_cell(r, moving_ranges_[j], gx, gy)) {
+						++last_duplicates_skipped_;
+						continue;
+					}
+					out.push_back(BroadphasePair{ a, j });
+				}
+				if (!query_static) continue;
+				for (uint32_t j : static_grid_.Query(gx, gy)) {
+					if (!filters[a].Accepts(static_filters_[j])) continue;
+					if (!first_shared_cell(r, static_ranges_[j], gx, gy)) {
+						++last_duplicates_skipped_;
+						continue;
+					}
+					out.push_back(BroadphasePair{ a, j | BroadphasePair::STATIC_BIT });
+				}
+			}
+		}
+	}
+}
+
+// 查询 box 覆盖的每个格子；跨越多个格子的条目会重复出现
+void GridBroadphase::QueryAabb(const CF_Aabb& box, std::vector<uint32_t>& out) const
+{
+	const CellRange r = to_range(box);
+	for (int32_t gx = r.gx0; gx <= r.gx1; ++gx) {
+		for (int32_t gy = r.gy0; gy <= r.gy1; ++gy) {
+			for (uint32_t j : moving_grid_.Query(gx, gy)) out.push_back(j);
+			for (uint32_t j : static_grid_.Query(gx, gy)) out.push_back(j | BroadphasePair::STATIC_BIT);
+		}
+	}
+}
+
+size_t GridBroadphase::GetEstimatedMemoryUsageBytes() const noexcept
+{
+	return static_aabbs_.capacity() * sizeof(CF_Aabb)
+		+ static_flags_.capacity()
+		+ static_filters_.capacity() * sizeof(CollisionFilter)
+		+ (static_ranges_.capacity() + moving_ranges_.capacity()) * sizeof(CellRange)
+		+ static_grid_.GetEstimatedMemoryUsageBytes()
+		+ moving_grid_.GetEstimatedMemoryUsageBytes();
+}
+
+//--------------------------SweepAndPruneBroadphase--------------------------
+
+static bool overlap_y(const CF_Aabb& a, const CF_Aabb& b) noexcept
+{
+	return a.min.y <= b.max.y && b.min.y <= a.max.y;
+}
+
+void SweepAndPruneBroadphase::SetStatic(const std::vector<CF_Aabb>& aabbs, const std::vector<uint8_t>& flags,
+	const std::vector<CollisionFilter>& filters)
+{
+	static_aabbs_ = aabbs;
+	static_filters_ = filters;
+	static_order_.clear();
+	for (size_t i = 0; i < aabbs.size(); ++i) {
+		if (flags[i] & BroadphaseFlag::ACTIVE) static_order_.push_back(static_cast<uint32_t>(i));
+	}
+	std::sort(static_order_.begin(), static_order_.end(), [this](uint32_t l, uint32_t r) {
+		return static_aabbs_[l].min.x < static_aabbs_[r].min.x;
+	});
+}
+
+// 保证 moving_order_ 恰好是 [0, count) 的一个排列：
+// - 运动分区 swap-pop 后尾部下标失效，需要剔除；新注册的下标追加到末尾，由随后的插入排序归位
+void SweepAndPruneBroadphase::sync_moving_order(size_t count)
+{
+	size_t w = 0;
+	for (size_t r = 0; r < moving_order_.size(); ++r) {
+		if (moving_order_[r] < count) moving_order_[w++] = moving_order_[r];
+	}
+	moving_order_.resize(w);
+
+	if (moving_order_.size() == count) return;
+	moving_present_.assign(count, 0);
+	for (uint32_t id : moving_order_) moving_present_[id] = 1;
+	for (size_t i = 0; i < count; ++i) {
+		if (!moving_present_[i]) moving_order_.push_back(static_cast<uint32_t>(i));
+	}
+}
+
+// 合并扫描运动序列与静态序列（均按 min.x 升序），活动集合中 max.x 落后于当前 min.x 的条目被惰性剔除
+void SweepAndPruneBroadphase::CollectPairs(const std::vector<CF_Aabb>& aabbs, const std::vector<uint8_t>& flags,
+	const std::vector<CollisionFilter>& filters, std::vector<BroadphasePair>& out)
+{
+	moving_aabbs_ = aabbs;
+	moving_flags_ = flags;
+	sync_moving_order(aabbs.size());
+
+	// 插入排序：帧间对象只移动少量距离时，交换次数接近 0
+	last_sort_swaps_ = 0;
+	for (size_t i = 1; i < moving_order_.size(); ++i) {
+		uint32_t id = moving_order_[i];
+		float key = aabbs[id].min.x;
+		size_t j = i;
+		while (j > 0 && aabbs[moving_order_[j - 1]].min.x > key) {
+			moving_order_[j] = moving_order_[j - 1];
+			--j;
+			++last_sort_swaps_;
+		}
+		moving_order_[j] = id;
+	}
+
+	active_moving_.clear();
+	active_static_.clear();
+
+	auto prune = [](std::vector<uint32_t>& active, const std::vector<CF_Aabb>& boxes, float x) {
+		for (size_t k = 0; k < active.size(); ) {
+			if (boxes[active[k]].max.x < x) {
+				active[k] = active.back();
+				active.pop_back();
+			}
+			else {
+				++k;
+			}
+		}
+	};
+
+	size_t mi = 0;
+	size_t si = 0;
+	while (mi < moving_order_.size()) {
+		const uint32_t mid = moving_order_[mi];
+		if (!(flags[mid] & BroadphaseFlag::ACTIVE)) { ++mi; continue; }
+
+		// 静态序列中 min.x 不大于当前运动条目的先入活动集合
+		if (si < static_order_.size() && static_aabbs_[static_order_[si]].min.x <= aabbs[mid].min.x) {
+			const uint32_t sid = static_order_[si++];
+			const CF_Aabb& sb = static_aabbs_[sid];
+			prune(active_moving_, aabbs, sb.min.x);
+			for (uint32_t k : active_moving_) {
+				if ((flags[k] & BroadphaseFlag::QUERY_STATIC) && overlap_y(aabbs[k], sb) && filters[k].Accepts(static_filters_[sid])) {
+					out.push_back(BroadphasePair{ k, sid | BroadphasePair::STATIC_BIT });
+				}
+			}
+			active_static_.push_back(sid);
+			continue;
+		}
+
+		const CF_Aabb& mb = aabbs[mid];
+		prune(active_moving_, aabbs, mb.min.x);
+		prune(active_static_, static_aabbs_, mb.min.x);
+		for (uint32_t k : active_moving_) {
+			if (!overlap_y(aabbs[k], mb) || !filters[k].Accepts(filters[mid])) continue;
+			out.push_back(k < mid ? BroadphasePair{ k, mid } : BroadphasePair{ mid, k });
+		}
+		if (flags[mid] & BroadphaseFlag::QUERY_STATIC) {
+			for (uint32_t s : active_static_) {
+				if (overlap_y(static_aabbs_[s], mb) && filters[mid].Accepts(static_filters_[s])) out.push_back(BroadphasePair{ mid, s | BroadphasePair::STATIC_BIT });
+			}
+		}
+		active_moving_.push_back(mid);
+		++mi;
+	}
+
+	// 运动序列扫描完后，剩余静态条目只需与仍在活动集合中的运动条目配对
+	while (si < static_order_.size() && !active_moving_.empty()) {
+		const uint32_t sid = static_order_[si++];
+		const CF_Aabb& sb = static_aabbs_[sid];
+		prune(active_moving_, aabbs, sb.min.x);
+		for (uint32_t k : active_moving_) {
+			if ((flags[k] & BroadphaseFlag::QUERY_STATIC) && overlap_y(aabbs[k], sb) && filters[k].Accepts(static_filters_[sid])) {
+				out.push_back(BroadphasePair{ k, sid | BroadphasePair::STATIC_BIT });
+			}
+		}
+	}
+}
+
+// 两条序列均按 min.x 升序，遇到 min.x 超出 box.max.x 即可停止
+void SweepAndPruneBroadphase::QueryAabb(const CF_Aabb& box, std::vector<uint32_t>& out) const
+{
+	for (uint32_t id : moving_order_) {
+		const CF_Aabb& b = moving_aabbs_[id];
+		if (b.min.x > box.max.x) break;
+		if ((moving_flags_[id] & BroadphaseFlag::ACTIVE) && overlap_aabb(b, box)) out.push_back(id);
+	}
+	for (uint32_t id : static_order_) {
+		const CF_Aabb& b = static_aabbs_[id];
+		if (b.min.x > box.max.x) break;
+		if (overlap_aabb(b, box)) out.push_back(id | BroadphasePair::STATIC_BIT);
+	}
+}
+
+size_t SweepAndPruneBroadphase::GetEstimatedMemoryUsageBytes() const noexcept
+{
+	return (static_aabbs_.capacity() + moving_aabbs_.capacity()) * sizeof(CF_Aabb)
+		+ moving_flags_.capacity()
+		+ static_filters_.capacity() * sizeof(CollisionFilter)
+		+ (static_order_.capacity() + moving_order_.capacity() + active_moving_.capacity() + active_static_.capacity()) * sizeof(uint32_t)
+		+ moving_present_.capacity();
+}
+
+//--------------------------AabbTreeBroadphase--------------------------
+
+void AabbTreeBroadphase::SetStatic(const std::vector<CF_Aabb>& aabbs, const std::vector<uint8_t>& flags,
+	const std::vector<CollisionFilter>& filters)
+{
+	// 分区缩小：销毁尾部多余的代理
+	for (size_t i = aabbs.size(); i < static_proxies_.size(); ++i) {
+		if (static_proxies_[i] != AabbTree::NULL_NODE) static_tree_.DestroyProxy(static_proxies_[i]);
+	}
+	static_proxies_.resize(aabbs.size(), AabbTree::NULL_NODE);
+	static_aabbs_.resize(aabbs.size());
+	static_filters_ = filters;
+
+	for (size_t i = 0; i < aabbs.size(); ++i) {
+		int32_t& proxy = static_proxies_[i];
+		const CF_Aabb& b = aabbs[i];
+		if (!(flags[i] & BroadphaseFlag::ACTIVE)) {
+			if (proxy != AabbTree::NULL_NODE) static_tree_.DestroyProxy(proxy);
+			proxy = AabbTree::NULL_NODE;
+			continue;
+		}
+		if (proxy == AabbTree::NULL_NODE) {
+			proxy = static_tree_.CreateProxy(b, static_cast<uint32_t>(i), 0.0f);
+		}
+		else {
+			const CF_Aabb& old = static_aabbs_[i];
+			if (old.min.x == b.min.x && old.min.y == b.min.y && old.max.x == b.max.x && old.max.y == b.max.y) continue;
+			// 静态树不使用胖 AABB：先销毁再插入，保证树中始终是紧 AABB
+			static_tree_.DestroyProxy(proxy);
+			proxy = static_tree_.CreateProxy(b, static_cast<uint32_t>(i), 0.0f);
+		}
+		static_aabbs_[i] = b;
+	}
+}
+
+void AabbTreeBroadphase::CollectPairs(const std::vector<CF_Aabb>& aabbs, const std::vector<uint8_t>& flags,
+	const std::vector<CollisionFilter>& filters, std::vector<BroadphasePair>& out)
+{
+	last_tree_updates_ = 0;
+	for (size_t i = aabbs.size(); i < moving_proxies_.size(); ++i) {
+		if (moving_proxies_[i] == AabbTree::NULL_NODE) continue;
+		moving_tree_.DestroyProxy(moving_proxies_[i]);
+		++last_tree_updates_;
+	}
+	moving_proxies_.resize(aabbs.size(), AabbTree::NULL_NODE);
+	moving_aabbs_.resize(aabbs.size());
+
+	// 1) 同步代理：实际 AABB 仍在胖 AABB 内时 MoveProxy 不修改树
+	for (size_t i = 0; i < aabbs.size(); ++i) {
+		int32_t& proxy = moving_proxies_[i];
+		const CF_Aabb& b = aabbs[i];
+		if (!(flags[i] & BroadphaseFlag::ACTIVE)) {
+			if (proxy != AabbTree::NULL_NODE) {
+				moving_tree_.DestroyProxy(proxy);
+				++last_tree_updates_;
+			}
+			proxy = AabbTree::NULL_NODE;
+			continue;
+		}
+		if (proxy == AabbTree::NULL_NODE) {
+			proxy = moving_tree_.CreateProxy(b, static_cast<uint32_t>(i), margin_);
+			++last_tree_updates_;
+		}
+		else {
+			const CF_Aabb& old = moving_aabbs_[i];
+			CF_V2 displacement = cf_v2(b.min.x - old.min.x, b.min.y - old.min.y);
+			if (moving_tree_.MoveProxy(proxy, b, displacement, margin_)) ++last_tree_updates_;
+		}
+		moving_aabbs_[i] = b;
+	}
+
+	// 2) 以紧 AABB 查询两棵树（运动-运动只保留 a < b）
+	for (size_t i = 0; i < aabbs.size(); ++i) {
+		if (moving_proxies_[i] == AabbTree::NULL_NODE) continue;
+		const uint32_t a = static_cast<uint32_t>(i);
+		const CF_Aabb& b = aabbs[i];
+		moving_tree_.Query(b, [&](uint32_t j) {
+			if (j > a && filters[a].Accepts(filters[j])) out.push_back(BroadphasePair{ a, j });
+			return true;
+		});
+		if (!(flags[i] & BroadphaseFlag::QUERY_STATIC)) continue;
+		static_tree_.Query(b, [&](uint32_t j) {
+			if (filters[a].Accepts(static_filters_[j])) out.push_back(BroadphasePair{ a, j | BroadphasePair::STATIC_BIT });
+			return true;
+		});
+	}
+}
+
+void AabbTreeBroadphase::QueryAabb(const CF_Aabb& box, std::vector<uint32_t>& out) const
+{
+	moving_tree_.Query(box, [&](uint32_t j) {
+		out.push_back(j);
+		return true;
+	});
+	static_tree_.Query(box, [&](uint32_t j) {
+		out.push_back(j | BroadphasePair::STATIC_BIT);
+		return true;
+	});
+}
+
+void AabbTreeBroadphase::QueryRay(CF_V2 origin, CF_V2 dir, float max_t, std::vector<uint32_t>& out) const
+{
+	moving_tree_.RayCast(origin, dir, max_t, [&](uint32_t j, float t) {
+		out.push_back(j);
+		return t;
+	});
+	static_tree_.RayCast(origin, dir, max_t, [&](uint32_t j, float t) {
+		out.push_back(j | BroadphasePair::STATIC_BIT);
+		return t;
+	});
+}
+
+size_t AabbTreeBroadphase::GetEstimatedMemoryUsageBytes() const noexcept
+{
+	return static_tree_.GetEstimatedMemoryUsageBytes()
+		+ moving_tree_.GetEstimatedMemoryUsageBytes()
+		+ (static_proxies_.capacity() + moving_proxies_.capacity()) * sizeof(int32_t)
+		+ (static_aabbs_.capacity() + moving_aabbs_.capacity()) * sizeof(CF_Aabb)
+		+ static_filters_.capacity() * sizeof(CollisionFilter);
+}
@@ -0,0 +1,94 @@
+#include "cell_grid.h"
+
+void CellGrid::Begin(size_t expected_refs)
+{
+	pending_.clear();
+	if (expected_refs > pending_.capacity()) pending_.reserve(expected_refs);
+}
+
+// 线性探测查找；遇到本次构建未使用的槽位即插入
+uint32_t CellGrid::find_or_insert(uint64_t key) noexcept
+{
+	uint64_t i = hash_key(key) & mask_;
+	for (;;) {
+		Slot& s = slots_[i];
+		if (s.stamp != stamp_) {
+			s.key = key;
+			s.stamp = stamp_;
+			s.count = 0;
+			used_slots_.push_back(static_cast<uint32_t>(i));
+			return static_cast<uint32_t>(i);
+		}
+		if (s.key == key) return static_cast<uint32_t>(i);
+		i = (i + 1) & mask_;
+	}
+}
+
+void CellGrid::Finalize()
+{
+	// 不同格子数量不超过 pending_.size()，表容量保持在其 2 倍以上以限制探测长度
+	size_t need = 16;
+	while (need < pending_.size() * 2) need <<= 1;
+	if (slots_.size() < need) {
+		slots_.assign(need, Slot{});
+		mask_ = need - 1;
+		stamp_ = 0;
+	}
+
+	// 代数戳回绕时整表清零，避免旧槽位被误判为有效
+	if (++stamp_ == 0) {
+		for (Slot& s : slots_) s.stamp = 0;
+		stamp_ = 1;
+	}
+	used_slots_.clear();
+
+	// 1) 计数
+	pending_slot_.resize(pending_.size());
+	for (size_t i = 0; i < pending_.size(); ++i) {
+		uint32_t si = find_or_insert(pending_[i].key);
+		pending_slot_[i] = si;
+		++slots_[si].count;
+	}
+
+	// 2) 前缀和：按格子首次出现顺序分配连续区间
+	uint32_t offset = 0;
+	for (uint32_t si : used_slots_) {
+		Slot& s = slots_[si];
+		s.start = offset;
+		s.cursor = offset;
+		offset += s.count;
+	}
+
+	// 3) 散列写入（同一格子内保持 Add 顺序）
+	items_.resize(offset);
+	for (size_t i = 0; i < pending_.size(); ++i) {
+		items_[slots_[pending_slot_[i]].cursor++] = pending_[i].value;
+	}
+}
+
+CellGrid::Span CellGrid::Query(int32_t gx, int32_t gy) const noexcept
+{
+	Span out;
+	if (slots_.empty()) return out;
+	uint64_t key = cell_key(gx, gy);
+	uint64_t i = hash_key(key) & mask_;
+	for (;;) {
+		const Slot& s = slots_[i];
+		if (s.stamp != stamp_) return out;
+		if (s.key == key) {
+			out.first = items_.data() + s.start;
+			out.last = out.first + s.count;
+			return out;
+		}
+		i = (i + 1) & mask_;
+	}
+}
+
+size_t CellGrid::GetEstimatedMemoryUsageBytes() const noexcept
+{
+	return slots_.capacity() * sizeof(Slot)
+		+ used_slots_.capacity() * sizeof(uint32_t)
+		+ pending_.capacity() * sizeof(Pending)
+		+ pending_slot_.capacity() * sizeof(uint32_t)
+		+ items_.capacity() * sizeof(uint32_t);
+}
@@ -150,17 +150,233 @@ static CF_Aabb shape_wrapper_to_aabb(const CF_ShapeWrapper& s) noexcept
 	return aabb;
 }
 
-// 使用 Cute Framework 的碰撞函数计算 world-space shape 的碰撞信息，
-// 并对结果进行基础校验和归一化，返回是否发生碰撞。
-// - 调用者应保证传入的 A/B 为 world-space（translate_shape_world 或 BasePhysics 已处理）
+// narrowphase 内核签名：A/B 为 world-space 形状，返回是否相交并写入未规范化的 manifold
+using NarrowKernel = bool (*)(const ShapeView& A, const ShapeView& B, CF_Manifold& m) noexcept;
+
+// 通用路径：交给 cf_collide
+static bool collide_generic(const ShapeView& A, const ShapeView& B, CF_Manifold& m) noexcept
+{
+	cf_collide(A.data, nullptr, A.type, B.data, nullptr, B.type, &m);
+	return m.count > 0;
+}
+
+// AABB-AABB 快速路径：与 cf_collide 的 AABB-AABB 分支结果一致（贴合视为相交、深度为 0），
+// 取重叠较小的轴作为法线（由 A 指向 B），接触点位于 A 在该方向上的面中心。
+static bool collide_aabb_aabb(const ShapeView& A, const ShapeView& B, CF_Manifold& m) noexcept
+{
+	const CF_Aabb& a = A.aabb();
+	const CF_Aabb& b = B.aabb();
+	const float ax = (a.min.x + a.max.x) * 0.5f, ay = (a.min.y + a.max.y) * 0.5f;
+	const float ex = std::fabs((a.max.x - a.min.x) * 0.5f), ey = std::fabs((a.max.y - a.min.y) * 0.5f);
+	const float dx = (b.min.x + b.max.x) * 0.5f - ax;
+	const float dy = (b.min.y + b.max.y) * 0.5f - ay;
+
+	const float ox = ex + std::fabs((b.max.x - b.min.x) * 0.5f) - std::fabs(dx);
+	if (ox < 0.0f) return false;
+	const float oy = ey + std::fabs((b.max.y - b.min.y) * 0.5f) - std::fabs(dy);
+	if (oy < 0.0f) return false;
+
+	m.count = 1;
+	if (ox < oy) {
+		const float sx = dx < 0.0f ? -1.0f : 1.0f;
+		m.n = cf_v2(sx, 0.0f);
+		m.depths[0] = ox;
+		m.contact_points[0] = cf_v2(ax + sx * ex, ay);
+	}
+	else {
+		const float sy = dy < 0.0f ? -1.0f : 1.0f;
+		m.n = cf_v2(0.0f, sy);
+		m.depths[0] = oy;
+		m.contact_points[0] = cf_v2(ax, ay + sy * ey);
+	}
+	return true;
+}
+
+// AABB-凸多边形的直接 manifold（尖刺等三角形为主），按 cute_c2 的 PolytoPoly 算法展开，不再经过 cf_collide：
+// 1) 分离轴：分别以 AABB 的四个面与多边形各边为参考面，求对方支撑点到参考面的最大有符号距离，任一 >= 0 即分离；
+//    AABB 的面轴对齐，多边形在其上的支撑点就是多边形包围盒的边，AABB 在多边形法线上的支撑点由法线符号直接选出角点；
+// 2) 参考面取分离度更大的一侧（带 0.95 相对 / 0.01 绝对容差，与 c2 一致）；
+// 3) 在另一侧找与参考面法线最反向的入射边，用参考面两端的侧平面裁剪，保留穿入参考面的点作为接触点（至多 2 个）。
+// 法线由 A(AABB) 指向 B(多边形)。与 cf_collide 一样要求多边形为逆时针且 norms 有效（cf_make_poly 的输出，
+// world shape 均满足）；AABB 的四个面按 c2 的顺序（-y, +x, +y, -x）编号，以保证平局时选出相同的参考面。
+static inline float dot2(CF_V2 a, CF_V2 b) noexcept { return a.x * b.x + a.y * b.y; }
+
+static inline CF_V2 box_vertex(const CF_Aabb& b, int i) noexcept
+{
+	switch (i & 3) {
+	case 0: return b.min;
+	case 1: return cf_v2(b.max.x, b.min.y);
+	case 2: return b.max;
+	default: return cf_v2(b.min.x, b.max.y);
+	}
+}
+
+static inline CF_V2 box_normal(int i) noexcept
+{
+	switch (i & 3) {
+	case 0: return cf_v2(0.0f, -1.0f);
+	case 1: return cf_v2(1.0f, 0.0f);
+	case 2: return cf_v2(0.0f, 1.0f);
+	default: return cf_v2(-1.0f, 0.0f);
+	}
+}
+
+// 把线段裁剪到平面 dot(n, p) <= d 的一侧，返回剩余点数
+static int clip_segment(CF_V2 seg[2], CF_V2 n, float d) noexcept
+{
+	CF_V2 out[2];
+	int sp = 0;
+	const float d0 = dot2(n, seg[0]) - d;
+	const float d1 = dot2(n, seg[1]) - d;
+	if (d0 < 0.0f) out[sp++] = seg[0];
+	if (d1 < 0.0f) out[sp++] = seg[1];
+	if (d0 == 0.0f && d1 == 0.0f) {
+		out[sp++] = seg[0];
+		out[sp++] = seg[1];
+	}
+	else if (d0 * d1 <= 0.0f && sp < 2) {
+		out[sp++] = seg[0] + (seg[1] - seg[0]) * (d0 / (d0 - d1));
+	}
+	seg[0] = out[0];
+	seg[1] = out[1];
+	return sp;
+}
+
+// 用参考边 ra -> rb（外法线 rn）裁剪入射边 seg 并写入接触点；没有接触点时返回 false
+static bool clip_to_reference(CF_V2 seg[2], CF_V2 ra, CF_V2 rb, CF_V2 rn, CF_Manifold& m) noexcept
+{
+	CF_V2 t = rb - ra;
+	const float tl = std::sqrt(dot2(t, t));
+	if (tl <= 0.0f) return false;
+	t = t * (1.0f / tl);
+	if (clip_segment(seg, cf_v2(-t.x, -t.y), -dot2(t, ra)) < 2) return false;
+	if (clip_segment(seg, t, dot2(t, rb)) < 2) return false;
+
+	const float rd = dot2(rn, ra);
+	int cp = 0;
+	for (int i = 0; i < 2; ++i) {
+		const float d = dot2(rn, seg[i]) - rd;
+		if (d <= 0.0f) {
+			m.contact_points[cp] = seg[i];
+			m.depths[cp] = -d;
+			++cp;
+		}
+	}
+	m.count = cp;
+	return cp > 0;
+}
+
+static bool aabb_poly_manifold(const CF_Aabb& box, const CF_Poly& poly, CF_Manifold& m) noexcept
+{
+	const int count = poly.count;
+	const CF_V2* v = poly.verts;
+	const CF_V2* n = poly.norms;
+
+	// 以 AABB 的面为参考面：多边形的支撑点即其包围盒的对应边
+	float minx = v[0].x, maxx = v[0].x, miny = v[0].y, maxy = v[0].y;
+	for (int i = 1; i < count; ++i) {
+		minx = std::min(minx, v[i].x); maxx = std::max(maxx, v[i].x);
+		miny = std::min(miny, v[i].y); maxy = std::max(maxy, v[i].y);
+	}
+	const float box_sep[4] = { box.min.y - maxy, minx - box.max.x, miny - box.max.y, box.min.x - maxx };
+	int ea = 0;
+	float sa = box_sep[0];
+	for (int i = 1; i < 4; ++i) {
+		if (box_sep[i] > sa) { sa = box_sep[i]; ea = i; }
+	}
+	if (sa >= 0.0f) return false;
+
+	// 以多边形的边为参考面：AABB 在 -n 方向上的支撑角点由法线符号决定
+	int eb = 0;
+	float sb = -INFINITY;
+	for (int i = 0; i < count; ++i) {
+		const CF_V2 corner = cf_v2(n[i].x > 0.0f ? box.min.x : box.max.x, n[i].y > 0.0f ? box.min.y : box.max.y);
+		const float d = dot2(n[i], corner) - dot2(n[i], v[i]);
+		if (d > sb) { sb = d; eb = i; }
+	}
+	if (sb >= 0.0f) return false;
+
+	constexpr float kRelTol = 0.95f, kAbsTol = 0.01f;
+	if (sa * kRelTol > sb + kAbsTol) {
+		// 参考面在 AABB 上，入射边取多边形中法线与之最反向的边
+		const CF_V2 rn = box_normal(ea);
+		int ie = 0;
+		float min_dot = dot2(rn, n[0]);
+		for (int i = 1; i < count; ++i) {
+			const float d = dot2(rn, n[i]);
+			if (d < min_dot) { min_dot = d; ie = i; }
+		}
+		CF_V2 seg[2] = { v[ie], v[ie + 1 < count ? ie + 1 : 0] };
+		if (!clip_to_reference(seg, box_vertex(box, ea), box_vertex(box, ea + 1), rn, m)) return false;
+		m.n = rn;
+		return true;
+	}
+
+	// 参考面在多边形上，入射边取 AABB 中法线与之最反向的面；法线翻转为由 AABB 指向多边形
+	const CF_V2 rn = n[eb];
+	int ie = 0;
+	float min_dot = dot2(rn, box_normal(0));
+	for (int i = 1; i < 4; ++i) {
+		const float d = dot2(rn, box_normal(i));
+		if (d < min_dot) { min_dot = d; ie = i; }
+	}
+	CF_V2 seg[2] = { box_vertex(box, ie), box_vertex(box, ie + 1) };
+	if (!clip_to_reference(seg, v[eb], v[eb + 1 < count ? eb + 1 : 0], rn, m)) return false;
+	m.n = cf_v2(-rn.x, -rn.y);
+	return true;
+}
+
+// 顶点数不足或超出 CF_Poly 容量的多边形交给 cf_collide
+static constexpr int MAX_POLY_VERTS = static_cast<int>(sizeof(CF_Poly{}.verts) / sizeof(CF_V2));
+
+static bool collide_aabb_poly(const ShapeView& A, const ShapeView& B, CF_Manifold& m) noexcept
+{
+	const CF_Poly& poly = B.poly();
+	if (poly.count < 3 || poly.count > MAX_POLY_VERTS) return collide_generic(A, B, m);
+	return aabb_poly_manifold(A.aabb(), poly, m);
+}
+
+// 多边形-AABB：与 cf_collide 相同，按 AABB-多边形计算后翻转法线
+static bool collide_poly_aabb(const ShapeView& A, const ShapeView& B, CF_Manifold& m) noexcept
+{
+	const CF_Poly& poly = A.poly();
+	if (poly.count < 3 || poly.count > MAX_POLY_VERTS) return collide_generic(A, B, m);
+	if (!aabb_poly_manifold(B.aabb(), poly, m)) return false;
+	m.n = cf_v2(-m.n.x, -m.n.y);
+	return true;
+}
+
+// 按 [A.type][B.type] 索引的 narrowphase 分派表；未特化的组合回退到 cf_collide
+static constexpr int NARROW_SHAPE_TYPES = CF_SHAPE_TYPE_POLY + 1;
+struct NarrowDispatchTable {
+	NarrowKernel k[NARROW_SHAPE_TYPES][NARROW_SHAPE_TYPES];
+
+	constexpr NarrowDispatchTable() : k{}
+	{
+		for (int a = 0; a < NARROW_SHAPE_TYPES; ++a)
+			for (int b = 0; b < NARROW_SHAPE_TYPES; ++b) k[a][b] = &collide_generic;
+		k[CF_SHAPE_TYPE_AABB][CF_SHAPE_TYPE_AABB] = &collide_aabb_aabb;
+		k[CF_SHAPE_TYPE_AABB][CF_SHAPE_TYPE_POLY] = &collide_aabb_poly;
+		k[CF_SHAPE_TYPE_POLY][CF_SHAPE_TYPE_AABB] = &collide_poly_aabb;
+	}
+};
+static constexpr NarrowDispatchTable s_narrow_dispatch{};
+
+// 计算 world-space shape 的碰撞信息，并对结果进行基础校验和归一化，返回是否发生碰撞。
+// - 常见组合（AABB-AABB、AABB-多边形）走 s_narrow_dispatch 中的专用内核，其余组合交给 cf_collide
+// - 调用者应保证传入的 A/B 为 world-space（WorldShapeStore 中的视图或 ShapeView::Of 包装的查询形状）
 // - out_manifold 为可选输出（若非 nullptr 则写入计算结果）
-static bool shapes_collide_world(const CF_ShapeWrapper& A, const CF_ShapeWrapper& B, CF_Manifold* out_manifold) noexcept
+static bool shapes_collide_world(const ShapeView& A, const ShapeView& B, CF_Manifold* out_manifold) noexcept
 {
-	CF_Manifold m{};
-	cf_collide(&A.u, nullptr, A.type, &B.u, nullptr, B.type, &m);
+	if (!A.data || !B.data) return false;
+	const unsigned ta = static_cast<unsigned>(A.type);
+	const unsigned tb = static_cast<unsigned>(B.type);
+	const NarrowKernel kernel = (ta < NARROW_SHAPE_TYPES && tb < NARROW_SHAPE_TYPES)
+		? s_narrow_dispatch.k[ta][tb] : &collide_generic;
 
 	// 如果没有接触点则认为未碰撞
-	if (m.count <= 0) return false;
+	CF_Manifold m{};
+	if (!kernel(A, B, m)) return false;
 
 	// 规范化 manifold 数据，防止数值异常
 	normalize_and_clamp_manifold(m);
@@ -169,278 +385,653 @@ static bool shapes_collide_world(const CF_ShapeWrapper& A, const CF_ShapeWrapper
 	return true;
 }
 
-static void merge_manifold_contact_points(CF_Manifold& base, const CF_Manifold& other) noexcept
+bool PhysicsSystem::CollideShapes(const ShapeView& a, const ShapeView& b, CF_Manifold* out) noexcept
 {
-	if (base.count >= 2 || other.count <= 0) return;
-	for (int i = 0; i < other.count && base.count < 2; ++i) {
-		const CF_V2& candidate = other.contact_points[i];
-		bool duplicate = false;
-		for (int j = 0; j < base.count; ++j) {
-			if (v2math::length(candidate-base.contact_points[j])) {
-				duplicate = true;
-				break;
-			}
+	return shapes_collide_world(a, b, out);
+}
+
+// 计算 BasePhysics 当前的 world-space 形状：get_shape 的缓存无论是否启用 world shape 都已平移到 position
+// （未启用时只是跳过旋转与 pivot），这里不能再次平移
+static CF_ShapeWrapper compute_world_shape(const BasePhysics* p) noexcept
+{
+	return p->get_shape();
+}
+
+// 扫掠 AABB 与静止 AABB 的最早接触时间（slab 法）：a_end 为位移结束时的 AABB，motion 为本帧相对位移。
+// 返回 [0,1] 内的接触时间；起点已经重叠（由离散 narrowphase 处理）或本帧不会接触时返回 -1。
+// out_axis 非空时写入最后进入重叠的轴（0 为 x，1 为 y），即接触面的法线方向
+static float sweep_aabb_toi(const CF_Aabb& a_end, CF_V2 motion, const CF_Aabb& b, int* out_axis = nullptr) noexcept
+{
+	float enter = -INFINITY;
+	float exit = INFINITY;
+	int enter_axis = 0;
+	const float a_min[2] = { a_end.min.x - motion.x, a_end.min.y - motion.y };
+	const float a_max[2] = { a_end.max.x - motion.x, a_end.max.y - motion.y };
+	const float b_min[2] = { b.min.x, b.min.y };
+	const float b_max[2] = { b.max.x, b.max.y };
+	const float d[2] = { motion.x, motion.y };
+	for (int axis = 0; axis < 2; ++axis) {
+		if (d[axis] == 0.0f) {
+			if (a_max[axis] < b_min[axis] || a_min[axis] > b_max[axis]) return -1.0f;
+			continue;
 		}
-		if (duplicate) continue;
-		base.contact_points[base.count] = candidate;
-		base.depths[base.count] = other.depths[i];
-		base.count += 1;
+		const float inv = 1.0f / d[axis];
+		float t0 = (b_min[axis] - a_max[axis]) * inv;
+		float t1 = (b_max[axis] - a_min[axis]) * inv;
+		if (t0 > t1) std::swap(t0, t1);
+		if (t0 > enter) {
+			enter = t0;
+			enter_axis = axis;
+		}
+		exit = std::min(exit, t1);
 	}
+	if (enter < 0.0f || enter > 1.0f || enter > exit) return -1.0f;
+	if (out_axis) *out_axis = enter_axis;
+	return enter;
+}
+
+float PhysicsSystem::SweepAabbToi(const CF_Aabb& a_end, CF_V2 motion, const CF_Aabb& b, int* out_axis) noexcept
+{
+	return sweep_aabb_toi(a_end, motion, b, out_axis);
+}
+
+CF_Aabb PhysicsSystem::ShapeAabb(const CF_ShapeWrapper& shape) noexcept
+{
+	return shape_wrapper_to_aabb(shape);
+}
+
+// 任意形状的扫掠接触时间：AABB-AABB 使用 sweep_aabb_toi，其余组合交给 cf_toi（A 从 end - motion 出发）。
+// 返回值含义同 sweep_aabb_toi；cf_toi 无法区分“起点重叠”与“起点接触”，因此 toi 为 0 时同样交给离散流程。
+static float sweep_shape_toi(const CF_ShapeWrapper& a_end, CF_V2 motion, const ShapeView& b) noexcept
+{
+	if (!b.data) return -1.0f;
+	if (a_end.type == CF_SHAPE_TYPE_AABB && b.type == CF_SHAPE_TYPE_AABB) {
+		return sweep_aabb_toi(a_end.u.aabb, motion, b.aabb());
+	}
+	const CF_ShapeWrapper a_start = translate_shape_world(a_end, -motion);
+	const CF_ToiResult r = cf_toi(&a_start.u, a_start.type, nullptr, motion, b.data, b.type, nullptr, cf_v2(0.0f, 0.0f), 0);
+	if (!r.hit || r.toi <= 0.0f || r.toi > 1.0f) return -1.0f;
+	return r.toi;
+}
+
+// 计算条目的 broadphase 标志：VOID 不参与；休眠体不与静态分区配对（其静态接触由 pair 缓存沿用）
+// - KINEMATIC 默认不与静态分区配对；自身订阅了 kinematic 接触，或存在订阅的静态体（kinematic_statics）时才查询，
+//   后者是保守的近似，多出的候选对在 Step 中按双方订阅状态再过滤
+static uint8_t broadphase_flags(const BasePhysics* p, bool kinematic_statics) noexcept
+{
+	if (!p || p->get_collider_type() == ColliderType::VOID) return 0;
+	uint8_t flags = BroadphaseFlag::ACTIVE;
+	if (p->is_sleeping()) return flags;
+	if (p->get_body_kind() != BodyKind::KINEMATIC || p->get_kinematic_contacts() || kinematic_statics) {
+		flags |= BroadphaseFlag::QUERY_STATIC;
+	}
+	return flags;
+}
+
+// KINEMATIC 与非 DYNAMIC 的对只有在任一方订阅了 kinematic 接触时才测试（其余分类组合不受影响）
+static bool kinematic_pair_wanted(const BasePhysics* a, const BasePhysics* b) noexcept
+{
+	const BodyKind ka = a->get_body_kind();
+	const BodyKind kb = b->get_body_kind();
+	if (ka == BodyKind::DYNAMIC || kb == BodyKind::DYNAMIC) return true;
+	if (ka != BodyKind::KINEMATIC && kb != BodyKind::KINEMATIC) return true;
+	return a->get_kinematic_contacts() || b->get_kinematic_contacts();
+}
+
+// 判断点是否位于 world-space 形状内（多边形按凸包处理，允许任意绕序）
+static bool shape_contains_point(const ShapeView& s, CF_V2 p) noexcept
+{
+	switch (s.type) {
+	case CF_SHAPE_TYPE_AABB:
+		return p.x >= s.aabb().min.x && p.x <= s.aabb().max.x && p.y >= s.aabb().min.y && p.y <= s.aabb().max.y;
+	case CF_SHAPE_TYPE_CIRCLE:
+		return v2math::length(p - s.circle().p) <= s.circle().r;
+	case CF_SHAPE_TYPE_CAPSULE:
+	{
+		const CF_Capsule& c = s.capsule();
+		CF_V2 ab = c.b - c.a;
+		float len2 = v2math::dot(ab, ab);
+		float t = len2 > 0.0f ? std::clamp(v2math::dot(p - c.a, ab) / len2, 0.0f, 1.0f) : 0.0f;
+		return v2math::length(p - (c.a + ab * t)) <= c.r;
+	}
+	case CF_SHAPE_TYPE_POLY:
+	{
+		const CF_Poly& poly = s.poly();
+		if (poly.count < 3) return false;
+		bool has_pos = false;
+		bool has_neg = false;
+		for (int i = 0; i < poly.count; ++i) {
+			const CF_V2& a = poly.verts[i];
+			const CF_V2& b = poly.verts[(i + 1) % poly.count];
+			float c = v2math::cross(b - a, p - a);
+			if (c > 0.0f) has_pos = true;
+			if (c < 0.0f) has_neg = true;
+			if (has_pos && has_neg) return false;
+		}
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+// 对候选引用排序去重（网格后端会在多个格子中重复返回同一条目）
+static void sort_unique_refs(std::vector<uint32_t>& refs)
+{
+	std::sort(refs.begin(), refs.end());
+	refs.erase(std::unique(refs.begin(), refs.end()), refs.end());
 }
 
 // 注意：PhysicsSystem 通过 ObjToken 管理 BasePhysics 的注册与反注册，从而在 Step() 中统一进行碰撞检测与回调。
-// 以下实现关注性能与稳定性：使用格子 broadphase 降低 narrowphase 次数，合并重复 contact 以限制每对最多两个 contact。
+// 以下实现关注性能与稳定性：使用可插拔 broadphase（见 broadphase.h）降低 narrowphase 次数，合并重复 contact 以限制每对最多两个 contact。
+// 对象按 BodyKind 分为两个分区：
+// - 静态分区（STATIC）：world shape 与 AABB 持久保存，仅在刷新队列中出现时才重新计算并提交给 broadphase；
+// - 运动分区（KINEMATIC/DYNAMIC）：每帧把 AABB 提交给 broadphase，取回与运动/静态条目的候选对。
 void PhysicsSystem::Register(const ObjManager::ObjToken& token, BasePhysics* phys) noexcept
 {
 	if (!phys) return;
 	uint64_t key = make_key(token);
 
+	phys->physics_registered_ = true;
+	phys->physics_key_ = key;
+	phys->wake_up();
+
+	auto sit = static_token_map_.find(key);
+	if (sit != static_token_map_.end()) {
+		static_entries_[sit->second].physics = phys;
+		static_entries_[sit->second].token = token;
+		phys->queue_partition_refresh();
+		return;
+	}
 	auto it = dynamic_token_map_.find(key);
 	if (it != dynamic_token_map_.end()) {
 		dynamic_entries_[it->second].physics = phys;
 		dynamic_entries_[it->second].token = token;
+		if (phys->get_body_kind() == BodyKind::STATIC) phys->queue_partition_refresh();
 		return;
 	}
+
 	Entry e;
 	e.token = token;
 	e.physics = phys;
-	dynamic_entries_.push_back(e);
-	dynamic_token_map_[key] = dynamic_entries_.size() - 1;
+	if (phys->get_body_kind() == BodyKind::STATIC) {
+		// 静态体先登记条目，真正提交给 broadphase 延迟到下一次 Step
+		static_entries_.push_back(e);
+		static_shapes_.Resize(static_entries_.size());
+		static_flags_.push_back(0);
+		static_filters_.emplace_back();
+		static_token_map_[key] = static_entries_.size() - 1;
+		phys->partition_refresh_queued_ = false;
+		phys->queue_partition_refresh();
+	}
+	else {
+		dynamic_entries_.push_back(e);
+		dynamic_token_map_[key] = dynamic_entries_.size() - 1;
+	}
+}
+
+void PhysicsSystem::QueuePartitionRefresh(uint64_t key) noexcept
+{
+	partition_refresh_queue_.push_back(key);
+}
+
+// 刷新静态条目的 world shape 与 AABB，并标记静态分区待重新提交
+// - VOID 类型不参与碰撞，标志为 0（仍保留条目以便之后切换类型）
+void PhysicsSystem::update_static_entry(size_t idx) noexcept
+{
+	BasePhysics* p = static_entries_[idx].physics;
+	static_flags_[idx] = 0;
+	static_dirty_ = true;
+	if (!p) return;
+
+	const CF_ShapeWrapper shape = compute_world_shape(p);
+	static_shapes_.Set(idx, shape, shape_wrapper_to_aabb(shape));
+	static_flags_[idx] = broadphase_flags(p, false);
+	static_filters_[idx] = p->get_collision_filter();
+	p->clear_position_dirty();
+}
+
+// 移除静态条目：尾部条目移动到 idx，静态分区在下一次 Step 重新提交
+void PhysicsSystem::remove_static_entry(size_t idx) noexcept
+{
+	static_token_map_.erase(make_key(static_entries_[idx].token));
+
+	size_t last = static_entries_.size() - 1;
+	if (idx != last) {
+		static_entries_[idx] = static_entries_[last];
+		static_shapes_.Copy(idx, last);
+		static_flags_[idx] = static_flags_[last];
+		static_filters_[idx] = static_filters_[last];
+		static_token_map_[make_key(static_entries_[idx].token)] = idx;
+	}
+	static_entries_.pop_back();
+	static_shapes_.Resize(last);
+	static_flags_.pop_back();
+	static_filters_.pop_back();
+	static_dirty_ = true;
+}
+
+// 移除运动条目：尾部条目移动到 idx（运动条目每帧重新提交给 broadphase，无需额外修正）
+void PhysicsSystem::remove_dynamic_entry(size_t idx) noexcept
+{
+	dynamic_token_map_.erase(make_key(dynamic_entries_[idx].token));
+	size_t last = dynamic_entries_.size() - 1;
+	if (idx != last) {
+		dynamic_entries_[idx] = dynamic_entries_[last];
+		// 同步上一帧的 world shape / AABB：保证两次 Step 之间的空间查询不会把 idx 解析为错误的形状，
+		// 休眠体在下一次 Step 也直接沿用这两项
+		if (last < moving_shapes_.Size()) moving_shapes_.Copy(idx, last);
+		dynamic_token_map_[make_key(dynamic_entries_[idx].token)] = idx;
+	}
+	dynamic_entries_.pop_back();
+}
+
+// 处理刷新队列：在分区之间迁移改变了 BodyKind 的条目，并重新计算移动过的静态体
+// - 任何静态变化都会在本函数末尾把静态分区整体提交给 broadphase 一次（由后端决定如何重建）
+void PhysicsSystem::process_partition_refresh() noexcept
+{
+	for (uint64_t key : partition_refresh_queue_) {
+		auto sit = static_token_map_.find(key);
+		if (sit != static_token_map_.end()) {
+			size_t idx = sit->second;
+			Entry e = static_entries_[idx];
+			if (!e.physics) continue;
+			e.physics->partition_refresh_queued_ = false;
+			if (e.physics->get_body_kind() == BodyKind::STATIC) {
+				update_static_entry(idx);
+			}
+			else {
+				remove_static_entry(idx);
+				e.physics->wake_up();
+				dynamic_entries_.push_back(e);
+				dynamic_token_map_[key] = dynamic_entries_.size() - 1;
+			}
+			continue;
+		}
+
+		auto dit = dynamic_token_map_.find(key);
+		if (dit == dynamic_token_map_.end()) continue; // 已反注册
+		Entry e = dynamic_entries_[dit->second];
+		if (!e.physics) continue;
+		e.physics->partition_refresh_queued_ = false;
+		if (e.physics->get_body_kind() != BodyKind::STATIC) continue;
+
+		remove_dynamic_entry(dit->second);
+		static_entries_.push_back(e);
+		static_shapes_.Resize(static_entries_.size());
+		static_flags_.push_back(0);
+		static_filters_.emplace_back();
+		static_token_map_[key] = static_entries_.size() - 1;
+		update_static_entry(static_entries_.size() - 1);
+	}
+	partition_refresh_queue_.clear();
+
+	if (static_dirty_) {
+		broadphase_->SetStatic(static_shapes_.Aabbs(), static_flags_, static_filters_);
+		static_dirty_ = false;
+		static_kinematic_listeners_ = 0;
+		for (const Entry& e : static_entries_) {
+			if (e.physics && e.physics->get_kinematic_contacts()) ++static_kinematic_listeners_;
+		}
+		stats_.static_rebuilds = 1;
+		// 休眠体不再查询静态分区：静态体变化（少见）时全部唤醒，由下一次 Step 重新配对
+		for (const Entry& e : dynamic_entries_) {
+			if (e.physics) e.physics->wake_up();
+		}
+	}
+}
+
+// 切换 broadphase 后端：旧后端的静态数据随之丢弃，标记静态分区待重新提交
+void PhysicsSystem::SetBroadphaseMode(BroadphaseMode mode)
+{
+	if (broadphase_->Mode() == mode) return;
+	switch (mode) {
+	case BroadphaseMode::SWEEP_AND_PRUNE:
+		broadphase_ = std::make_unique<SweepAndPruneBroadphase>();
+		break;
+	case BroadphaseMode::AABB_TREE:
+		broadphase_ = std::make_unique<AabbTreeBroadphase>();
+		break;
+	case BroadphaseMode::GRID:
+	default:
+		broadphase_ = std::make_unique<GridBroadphase>();
+		break;
+	}
+	static_dirty_ = true;
 }
 
-// 反注册：将条目从 entries_ 中移除并维护映射一致性
-// - 将尾部条目移动到被删除位置以避免 O(n) 删除成本，同时更新 token_map_
-void PhysicsSystem::Unregister(const ObjManager::ObjToken& token) noexcept
+// 反注册：将条目从所在分区中移除并维护映射一致性
+// - 将尾部条目移动到被删除位置以避免 O(n) 删除成本，同时更新 token_map_（静态分区标记网格待重建）
+// - 碰撞对记录不再整表扫描：沿该物体的接触链表把相关对标记为 removed，下一次 Step 的归并自然丢弃它们
+void PhysicsSystem::Unregister(const ObjManager::ObjToken& token, bool notify_exit) noexcept
 {
 	uint64_t key = make_key(token);
 
+	BasePhysics* p = nullptr;
 	auto static_it = static_token_map_.find(key);
 	if (static_it != static_token_map_.end()) {
-		size_t idx = static_it->second;
-		size_t last = static_entries_.size() - 1;
-		if (idx != last) {
-			static_entries_[idx] = static_entries_[last];
-			uint64_t moved_key = make_key(static_entries_[idx].token);
-			static_token_map_[moved_key] = idx;
-		}
-		static_entries_.pop_back();
-		static_token_map_.erase(static_it);
+		p = static_entries_[static_it->second].physics;
+		remove_static_entry(static_it->second);
 	}
 	else {
 		auto dynamic_it = dynamic_token_map_.find(key);
 		if (dynamic_it == dynamic_token_map_.end()) return;
-		size_t idx = dynamic_it->second;
-		size_t last = dynamic_entries_.size() - 1;
-		if (idx != last) {
-			dynamic_entries_[idx] = dynamic_entries_[last];
-			uint64_t moved_key = make_key(dynamic_entries_[idx].token);
-			dynamic_token_map_[moved_key] = idx;
-		}
-		dynamic_entries_.pop_back();
-		dynamic_token_map_.erase(dynamic_it);
+		p = dynamic_entries_[dynamic_it->second].physics;
+		remove_dynamic_entry(dynamic_it->second);
 	}
+	if (!p) return;
+	p->physics_registered_ = false;
+	p->partition_refresh_queued_ = false;
 
+	if (p->contact_stamp_ != frame_stamp_) return;
+	p->contact_stamp_ = 0;
+	ObjManager& objs = ObjManager::Instance();
+	for (uint32_t idx = p->contact_head_; idx != NO_CONTACT;) {
+		ActivePair& ap = prev_collision_pairs_[idx];
+		const bool self_first = ap.key.lo == key;
+		idx = self_first ? ap.next_first : ap.next_second;
+		if (ap.removed) continue;
+		ap.removed = true;
 
-    // 修复：当对象被销毁时，从碰撞对记录中移除相关条目，防止内存泄漏和性能下降
-    auto clean_pairs = [&](auto& pairs_map) {
-        for (auto it = pairs_map.begin(); it != pairs_map.end(); ) {
-            if (make_key(it->second.first) == key || make_key(it->second.second) == key) {
-                it = pairs_map.erase(it);
-            } else {
-                ++it;
-            }
-        }
-    };
+		// 对方仍存活时立即派发 Exit（空 manifold），与 Step 的 Exit 路径一样经 OnCollisionState 分发，
+		// 以保持排斥逻辑与 m_collide_manifolds 记录一致（此时 token 仍有效，对象尚未析构）
+		const ObjManager::ObjToken& other = self_first ? ap.second : ap.first;
+		if (!notify_exit || !objs.IsValid(other)) continue;
+#if COLLISION_DEBUG
+		OUTPUT({ "Physics" }, "Collision EXIT (unregister): a =", token.index, "b =", other.index);
+#endif
+		objs[other].OnCollisionState(token, CF_Manifold{}, BaseObject::CollisionPhase::Exit);
+	}
+}
+
+void PhysicsSystem::Clear() noexcept
+{
+	auto detach = [](std::vector<Entry>& entries) {
+		for (Entry& e : entries) {
+			if (!e.physics) continue;
+			e.physics->physics_registered_ = false;
+			e.physics->partition_refresh_queued_ = false;
+			e.physics->contact_stamp_ = 0;
+		}
+		entries.clear();
+	};
+	detach(dynamic_entries_);
+	detach(static_entries_);
+	dynamic_token_map_.clear();
+	static_token_map_.clear();
+	static_shapes_.Resize(0);
+	static_flags_.clear();
+	static_filters_.clear();
+	static_dirty_ = true;
+	static_kinematic_listeners_ = 0;
+	partition_refresh_queue_.clear();
+	moving_shapes_.Resize(0);
 
-    clean_pairs(prev_collision_pairs_);
-    clean_pairs(current_pairs_);
+	pair_cache_.clear();
+	events_.clear();
+	prev_collision_pairs_.clear();
+	current_pairs_.clear();
 }
 
 void PhysicsSystem::Step(float cell_size) noexcept
 {
 	events_.clear();
+	stats_ = StepStats{};
+
+	// 先应用静态体的移动/变更与 BodyKind 迁移，保证本帧 broadphase 中的静态分区是最新的
+	broadphase_->SetCellSize(cell_size);
+	process_partition_refresh();
+
+	stats_.moving_bodies = dynamic_entries_.size();
+	stats_.static_bodies = static_entries_.size();
+
 	if (dynamic_entries_.empty() && static_entries_.empty()) return;
 
-	// 清空上次 frame 使用过的网格 bucket，以便复用容器
-	for (uint64_t k : grid_keys_used_) {
-		auto git = grid_.find(k);
-		if (git != grid_.end()) {
-			git->second.clear();
+	// 运动分区：每帧计算 world shape 与 AABB，一次性提交给 broadphase 收集候选对
+	moving_shapes_.Resize(dynamic_entries_.size());
+	continuous_bodies_.clear();
+	moving_flags_.resize(dynamic_entries_.size());
+	moving_filters_.resize(dynamic_entries_.size());
+	for (size_t i = 0; i < dynamic_entries_.size(); ++i) {
+		BasePhysics* p = dynamic_entries_[i].physics;
+		if (!p) {
+			moving_flags_[i] = 0;
+			continue;
 		}
-	}
-	grid_keys_used_.clear();
 
-	// 调整 world_shapes_ 大小以容纳所有对象
-	world_shapes_.resize(dynamic_entries_.size() + static_entries_.size());
+		// 休眠体在 world shape 变脏或获得速度时唤醒；仍在休眠则沿用上一帧的 world shape 与 AABB
+		const CF_V2& vel = p->get_velocity();
+		if (p->sleeping_ && (p->world_shape_dirty_ || vel.x != 0.0f || vel.y != 0.0f)) p->wake_up();
+		// 激活区域外的条目不提交给 broadphase（激活状态已由 ObjManager 在帧首刷新）
+		if (!p->region_active_) {
+			moving_flags_[i] = 0;
+			++stats_.inactive_bodies;
+			continue;
+		}
+		moving_flags_[i] = broadphase_flags(p, static_kinematic_listeners_ != 0);
+		moving_filters_[i] = p->get_collision_filter();
+		if (p->sleeping_) {
+			++stats_.sleeping_bodies;
+			continue;
+		}
 
-	// 辅助函数：将对象更新并放入网格
-	auto update_entry_in_grid = [&](Entry& entry, size_t world_shape_idx) {
-		BasePhysics* p = entry.physics;
-		if (!p) return;
+		const CF_ShapeWrapper shape = compute_world_shape(p);
+		moving_shapes_.Set(i, shape, shape_wrapper_to_aabb(shape));
+		p->clear_position_dirty();
+		if (p->continuous_ && (vel.x != 0.0f || vel.y != 0.0f) && moving_flags_[i]) {
+			continuous_bodies_.push_back(static_cast<uint32_t>(i));
+		}
 
-		// 仅当对象是动态的或首次注册时才更新网格
-		CF_ShapeWrapper ws;
-		if (entry.dirty) {
-			CF_ShapeWrapper s = p->get_shape();
-			if (p->is_world_shape_enabled()) {
-				ws = s;
-			}
-			else {
-				ws = translate_shape_world(s, p->get_position());
-			}
-			world_shapes_[world_shape_idx] = ws;
+		// 连续静止计数：world shape 版本不变且速度为 0 时累加，达到 SLEEP_FRAMES 后从下一帧起休眠
+		const uint64_t version = p->world_shape_version();
+		if (version == p->rest_version_ && vel.x == 0.0f && vel.y == 0.0f) {
+			if (p->rest_frames_ < SLEEP_FRAMES) ++p->rest_frames_;
+			if (p->rest_frames_ >= SLEEP_FRAMES && p->allow_sleep_) p->sleeping_ = true;
 		}
 		else {
-			ws = world_shapes_[world_shape_idx];
+			p->rest_version_ = version;
+			p->rest_frames_ = 0;
 		}
+	}
 
-		CF_Aabb waabb = shape_wrapper_to_aabb(ws);
-
-		int32_t gx0 = static_cast<int32_t>(std::floor(waabb.min.x / cell_size));
-		int32_t gy0 = static_cast<int32_t>(std::floor(waabb.min.y / cell_size));
-		int32_t gx1 = static_cast<int32_t>(std::floor(waabb.max.x / cell_size));
-		int32_t gy1 = static_cast<int32_t>(std::floor(waabb.max.y / cell_size));
+	// 连续碰撞条目以起点与终点的包围盒参与 broadphase，保证途经的对象都成为候选
+	pairs_.clear();
+	if (continuous_bodies_.empty()) {
+		broadphase_->CollectPairs(moving_shapes_.Aabbs(), moving_flags_, moving_filters_, pairs_);
+	}
+	else {
+		swept_aabbs_ = moving_shapes_.Aabbs();
+		for (uint32_t i : continuous_bodies_) {
+			const CF_V2& vel = dynamic_entries_[i].physics->get_velocity();
+			CF_Aabb& box = swept_aabbs_[i];
+			box.min = cf_v2(std::min(box.min.x, box.min.x - vel.x), std::min(box.min.y, box.min.y - vel.y));
+			box.max = cf_v2(std::max(box.max.x, box.max.x - vel.x), std::max(box.max.y, box.max.y - vel.y));
+		}
+		broadphase_->CollectPairs(swept_aabbs_, moving_flags_, moving_filters_, pairs_);
+		resolve_continuous();
+	}
+	stats_.broadphase_pairs = pairs_.size();
+	if (broadphase_->Mode() == BroadphaseMode::GRID) {
+		const GridBroadphase& grid = static_cast<const GridBroadphase&>(*broadphase_);
+		stats_.moving_cells = grid.MovingCellCount();
+		stats_.moving_cell_refs = grid.MovingRefCount();
+		stats_.static_cells = grid.StaticCellCount();
+		stats_.static_cell_refs = grid.StaticRefCount();
+		stats_.duplicate_pairs_skipped = grid.LastDuplicatesSkipped();
 
-		for (int32_t gx = gx0; gx <= gx1; ++gx) {
-			for (int32_t gy = gy0; gy <= gy1; ++gy) {
-				uint64_t gkey = grid_key(gx, gy);
-				grid_[gkey].push_back(world_shape_idx);
-				grid_keys_used_.emplace_back(gkey);
+		// 网格只保证两者共享格子；先对所有候选对做一次批量 AABB 重叠测试，只有重叠的对进入 narrowphase
+		pair_aabbs_.Clear();
+		pair_aabbs_.Reserve(pairs_.size());
+		for (const BroadphasePair& pair : pairs_) {
+			const CF_Aabb& b = (pair.b & BroadphasePair::STATIC_BIT)
+				? static_shapes_.Aabb(pair.b & ~BroadphasePair::STATIC_BIT) : moving_shapes_.Aabb(pair.b);
+			pair_aabbs_.Push(moving_shapes_.Aabb(pair.a), b);
+		}
+		const size_t survivors = pair_aabbs_.TestOverlap(pair_overlap_);
+		if (survivors != pairs_.size()) {
+			size_t w = 0;
+			for (size_t i = 0; i < pairs_.size(); ++i) {
+				if (pair_overlap_[i]) pairs_[w++] = pairs_[i];
 			}
+			pairs_.resize(w);
 		}
-
-		CF_V2 center = (waabb.min + waabb.max) * 0.5f;
-		entry.grid_x = static_cast<int32_t>(std::floor(center.x / cell_size));
-		entry.grid_y = static_cast<int32_t>(std::floor(center.y / cell_size));
-
-		p->clear_position_dirty();
-	};
-
-	// 更新动态对象
-	for (size_t i = 0; i < dynamic_entries_.size(); ++i) {
-		update_entry_in_grid(dynamic_entries_[i], i);
+		stats_.aabb_rejected_pairs = stats_.broadphase_pairs - survivors;
 	}
-
-	// 更新静态对象（仅在首次或需要时）
-	size_t static_offset = dynamic_entries_.size();
-	for (size_t i = 0; i < static_entries_.size(); ++i) {
-		update_entry_in_grid(static_entries_[i], static_offset + i);
+	else if (broadphase_->Mode() == BroadphaseMode::SWEEP_AND_PRUNE) {
+		stats_.sort_swaps = static_cast<const SweepAndPruneBroadphase&>(*broadphase_).LastSortSwaps();
+	}
+	else if (broadphase_->Mode() == BroadphaseMode::AABB_TREE) {
+		stats_.tree_updates = static_cast<const AabbTreeBroadphase&>(*broadphase_).LastTreeUpdates();
 	}
-
 
 	// 进行 narrowphase
 	events_.reserve(dynamic_entries_.size() * 2); // 预估容量
+	++frame_stamp_;
 
-	// 辅助函数：执行碰撞检测
-	auto check_collisions_for_bucket = [&](size_t i, const std::vector<size_t>& bucket) {
-		Entry& a_entry = (i < static_offset) ? dynamic_entries_[i] : static_entries_[i - static_offset];
-		BasePhysics* pa = a_entry.physics;
-		if (!pa || pa->get_collider_type() == ColliderType::VOID) return;
-
-		for (size_t j_idx : bucket) {
-			if (j_idx <= i) continue;
+	// 1) 串行：查 pair 缓存，双方 world shape 版本与上次测试时相同则直接复用结果，否则生成 narrowphase 任务
+	// - unordered_map 的元素引用在插入/rehash 后仍然有效，任务与结果可以直接持有 CachedPair*
+	// - broadphase 保证每对只出现一次，因此每对最多产生一个任务
+	narrow_results_.clear();
+	narrow_jobs_.clear();
+	auto schedule = [&](const Entry& a_entry, ShapeView aw, const Entry& b_entry, ShapeView bw) {
+		const uint64_t ka = make_key(a_entry.token);
+		const uint64_t kb = make_key(b_entry.token);
+		const uint64_t va = a_entry.physics->world_shape_version();
+		const uint64_t vb = b_entry.physics->world_shape_version();
+		const bool a_first = ka <= kb;
+		const uint64_t v_lo = a_first ? va : vb;
+		const uint64_t v_hi = a_first ? vb : va;
 
-			Entry& b_entry = (j_idx < static_offset) ? dynamic_entries_[j_idx] : static_entries_[j_idx - static_offset];
-			BasePhysics* pb = b_entry.physics;
-			if (!pb || pb->get_collider_type() == ColliderType::VOID) continue;
-
-			CF_Manifold m{};
-			const CF_ShapeWrapper& aw = world_shapes_[i];
-			const CF_ShapeWrapper& bw = world_shapes_[j_idx];
-			if (shapes_collide_world(aw, bw, &m)) {
-				CollisionEvent ev;
-				ev.a = a_entry.token;
-				ev.b = b_entry.token;
-				ev.manifold = m;
-
-				CF_V2 aver = cf_v2(0.0f, 0.0f);
-				for (int p = 0; p < m.count; p++) aver += m.contact_points[p];
-				aver = aver * (1.0f / static_cast<float>(m.count));
-				ev.distance_a = v2math::length(aver - pa->get_position());
-				ev.distance_b = v2math::length(aver - pb->get_position());
-
-				events_.push_back(ev);
-			}
+		auto cached = pair_cache_.try_emplace(PairKey{ a_first ? ka : kb, a_first ? kb : ka });
+		CachedPair& c = cached.first->second;
+		narrow_results_.push_back(&c);
+		if (!cached.second && c.version_lo == v_lo && c.version_hi == v_hi) {
+			++stats_.cached_pairs;
+			c.stamp = frame_stamp_;
+			return;
 		}
+		c.version_lo = v_lo;
+		c.version_hi = v_hi;
+		c.stamp = frame_stamp_;
+		c.hit = false;
+		narrow_jobs_.push_back(NarrowphaseJob{ &c, &a_entry, &b_entry, aw, bw });
 	};
 
-	for (size_t i = 0; i < dynamic_entries_.size(); ++i) {
-		Entry& a = dynamic_entries_[i];
-		for (int dx = -1; dx <= 1; ++dx) {
-			for (int dy = -1; dy <= 1; ++dy) {
-				uint64_t nkey = grid_key(a.grid_x + dx, a.grid_y + dy);
-				auto nit = grid_.find(nkey);
-				if (nit != grid_.end()) {
-					check_collisions_for_bucket(i, nit->second);
-				}
-			}
+	// 候选对规则：STATIC-STATIC 从不测试；DYNAMIC 与所有分类测试；KINEMATIC 与 STATIC/KINEMATIC 仅在任一方订阅
+	// kinematic 接触时测试（VOID 已由 broadphase 标志排除；未订阅的 KINEMATIC-STATIC 通常也已在 broadphase 排除）
+	for (const BroadphasePair& pair : pairs_) {
+		const Entry& a = dynamic_entries_[pair.a];
+		if (pair.b & BroadphasePair::STATIC_BIT) {
+			const uint32_t j = pair.b & ~BroadphasePair::STATIC_BIT;
+			if (!kinematic_pair_wanted(a.physics, static_entries_[j].physics)) continue;
+			schedule(a, moving_shapes_.View(pair.a), static_entries_[j], static_shapes_.View(j));
+			continue;
 		}
+		const Entry& b = dynamic_entries_[pair.b];
+		if (!kinematic_pair_wanted(a.physics, b.physics)) continue;
+		if (a.physics->sleeping_ && b.physics->sleeping_) continue; // 双方休眠：由下方的缓存沿用处理
+		schedule(a, moving_shapes_.View(pair.a), b, moving_shapes_.View(pair.b));
 	}
 
-	// 进行 narrowphase后排序和去重
-	auto make_pair_key_and_ordered_tokens = [this](const ObjManager::ObjToken& t1, const ObjManager::ObjToken& t2,
-		uint64_t& out_key, ObjManager::ObjToken& out_first, ObjManager::ObjToken& out_second) noexcept
-		{
-			uint64_t k1 = make_key(t1);
-			uint64_t k2 = make_key(t2);
-			if (k1 <= k2) {
-				out_first = t1;
-				out_second = t2;
-				out_key = k1 ^ (k2 + 0x9e3779b97f4a7c15ULL + (k1 << 6) + (k1 >> 2));
-			}
-			else {
-				out_first = t2;
-				out_second = t1;
-				out_key = k2 ^ (k1 + 0x9e3779b97f4a7c15ULL + (k2 << 6) + (k2 >> 2));
-			}
-		};
-	
-	if (!events_.empty()) {
-		std::unordered_map<uint64_t, CollisionEvent> unique_events;
-		unique_events.reserve(events_.size());
-		for (const auto& ev : events_) {
-			uint64_t pair_key;
-			ObjManager::ObjToken first_tok;
-			ObjManager::ObjToken second_tok;
-			make_pair_key_and_ordered_tokens(ev.a, ev.b, pair_key, first_tok, second_tok);
-			auto emplaced = unique_events.emplace(pair_key, ev);
-			if (!emplaced.second) {
-				merge_manifold_contact_points(emplaced.first->second.manifold, ev.manifold);
-			}
-		}
-		events_.clear();
-		events_.reserve(unique_events.size());
-		for (auto& kv : unique_events) {
-			events_.push_back(kv.second);
+	// 2) 并行：每个任务只写自己的 CachedPair，工作线程之间没有共享写入
+	stats_.narrowphase_tests = narrow_jobs_.size();
+	workers_.ParallelFor(narrow_jobs_.size(), NARROWPHASE_BATCH, [this](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			const NarrowphaseJob& job = narrow_jobs_[i];
+			CF_Manifold m{};
+			if (!shapes_collide_world(job.aw, job.bw, &m)) continue;
+
+			CollisionEvent& ev = job.cache->event;
+			ev.a = job.a->token;
+			ev.b = job.b->token;
+			ev.manifold = m;
+
+			CF_V2 aver = cf_v2(0.0f, 0.0f);
+			for (int p = 0; p < m.count; p++) aver += m.contact_points[p];
+			aver = aver * (1.0f / static_cast<float>(m.count));
+			ev.distance_a = v2math::length(aver - job.a->physics->get_position());
+			ev.distance_b = v2math::length(aver - job.b->physics->get_position());
+			job.cache->hit = true;
 		}
+	});
+
+	// 3) 串行：按候选对顺序写入 events_，与线程数无关
+	for (const CachedPair* c : narrow_results_) {
+		if (c->hit) events_.push_back(c->event);
 	}
 
-	if (events_.size() > 1) {
-		std::sort(events_.begin(), events_.end(), [](const CollisionEvent& lhs, const CollisionEvent& rhs) {
-			return lhs.distance_a != rhs.distance_a? lhs.distance_a < rhs.distance_a : lhs.distance_b < rhs.distance_b;
-		});
+	// 本帧未被测试的缓存条目：双方都静止（休眠/静态）且版本未变的接触继续产生事件，其余条目淘汰
+	for (auto it = pair_cache_.begin(); it != pair_cache_.end(); ) {
+		CachedPair& c = it->second;
+		if (c.stamp == frame_stamp_) {
+			++it;
+			continue;
+		}
+		if (c.hit && is_resting(it->first.lo, c.version_lo) && is_resting(it->first.hi, c.version_hi)) {
+			c.stamp = frame_stamp_;
+			events_.push_back(c.event);
+			++stats_.persisted_contacts;
+			++it;
+			continue;
+		}
+		it = pair_cache_.erase(it);
 	}
+	stats_.raw_events = events_.size();
 
-	// 使用事件产生 Enter/Stay/Exit 回调序列
+	// 以精确的 PairKey 排序本帧碰撞对（broadphase 已保证每对只出现一次，这里只需排序以便与上一帧归并）
+	// - 已失效的 token 不进入本帧碰撞对（ObjManager 的销毁是延迟的，Step 期间有效性不会改变）
+	ObjManager& objs = ObjManager::Instance();
 	current_pairs_.clear();
-	current_pairs_.reserve(events_.size() * 2);
-
-	for (const auto& ev : events_) {
-		if (!ObjManager::Instance().IsValid(ev.a) || !ObjManager::Instance().IsValid(ev.b)) continue;
+	current_pairs_.reserve(events_.size());
+	for (size_t i = 0; i < events_.size(); ++i) {
+		const CollisionEvent& ev = events_[i];
+		if (!objs.IsValid(ev.a) || !objs.IsValid(ev.b)) continue;
+		const uint64_t ka = make_key(ev.a);
+		const uint64_t kb = make_key(ev.b);
+		ActivePair ap;
+		ap.key = PairKey::Make(ka, kb);
+		ap.first = ka <= kb ? ev.a : ev.b;
+		ap.second = ka <= kb ? ev.b : ev.a;
+		ap.event = static_cast<uint32_t>(i);
+		current_pairs_.push_back(ap);
+	}
+	std::sort(current_pairs_.begin(), current_pairs_.end(), [](const ActivePair& lhs, const ActivePair& rhs) {
+		return lhs.key < rhs.key;
+	});
 
-		uint64_t pair_key;
-		ObjManager::ObjToken first_tok;
-		ObjManager::ObjToken second_tok;
-		make_pair_key_and_ordered_tokens(ev.a, ev.b, pair_key, first_tok, second_tok);
+	// 线性归并上一帧与本帧的有序数组：两边都有为 Stay，只在本帧为 Enter，只在上一帧为 Exit
+	exit_pairs_.clear();
+	size_t prev_i = 0;
+	for (ActivePair& cur : current_pairs_) {
+		while (prev_i < prev_collision_pairs_.size() && prev_collision_pairs_[prev_i].key < cur.key) {
+			exit_pairs_.push_back(static_cast<uint32_t>(prev_i++));
+		}
+		cur.was_colliding = prev_i < prev_collision_pairs_.size() && prev_collision_pairs_[prev_i].key == cur.key;
+		if (cur.was_colliding) ++prev_i;
+	}
+	while (prev_i < prev_collision_pairs_.size()) exit_pairs_.push_back(static_cast<uint32_t>(prev_i++));
 
-		current_pairs_.emplace(pair_key, std::make_pair(first_tok, second_tok));
+	// 回调顺序：按接触距离排序（距离相同时按 key，保证顺序确定）
+	dispatch_order_.resize(current_pairs_.size());
+	for (size_t i = 0; i < dispatch_order_.size(); ++i) dispatch_order_[i] = static_cast<uint32_t>(i);
+	if (dispatch_order_.size() > 1) {
+		std::sort(dispatch_order_.begin(), dispatch_order_.end(), [this](uint32_t l, uint32_t r) {
+			const CollisionEvent& lhs = events_[current_pairs_[l].event];
+			const CollisionEvent& rhs = events_[current_pairs_[r].event];
+			if (lhs.distance_a != rhs.distance_a) return lhs.distance_a < rhs.distance_a;
+			if (lhs.distance_b != rhs.distance_b) return lhs.distance_b < rhs.distance_b;
+			return l < r;
+		});
+	}
 
-		auto prev_it = prev_collision_pairs_.find(pair_key);
-		const bool was_colliding = (prev_it != prev_collision_pairs_.end());
+	// 使用事件产生 Enter/Stay 回调序列
+	for (uint32_t order : dispatch_order_) {
+		const ActivePair& cur = current_pairs_[order];
+		const CollisionEvent& ev = events_[cur.event];
 
 		// 使用 token-based 的 operator[] 获取对象引用（在前面已通过 IsValid 校验，operator[] 不应抛出）
-		BaseObject& oa = ObjManager::Instance()[ev.a];
-		BaseObject& ob = ObjManager::Instance()[ev.b];
+		BaseObject& oa = objs[ev.a];
+		BaseObject& ob = objs[ev.b];
 
 		auto orient_manifold = [](const CF_Manifold& src, const BaseObject& self, const BaseObject& other) {
 			CF_Manifold out = src;
@@ -456,7 +1047,7 @@ void PhysicsSystem::Step(float cell_size) noexcept
 
 		CF_Manifold manifold_for_a = orient_manifold(ev.manifold, oa, ob);
 		CF_Manifold manifold_for_b = orient_manifold(ev.manifold, ob, oa);
-			if (was_colliding) {
+			if (cur.was_colliding) {
 				oa.OnCollisionState(ev.b, manifold_for_a, BaseObject::CollisionPhase::Stay);
 				ob.OnCollisionState(ev.a, manifold_for_b, BaseObject::CollisionPhase::Stay);
 			}
@@ -470,28 +1061,281 @@ void PhysicsSystem::Step(float cell_size) noexcept
 			}
 	}
 
-	// 对上帧存在但本帧消失的对触发 Exit 回调
-	for (const auto& prev_pair : prev_collision_pairs_) {
-		uint64_t key = prev_pair.first;
-		if (current_pairs_.find(key) == current_pairs_.end()) {
-			const auto& tok_pair = prev_pair.second;
-			const ObjManager::ObjToken& ta = tok_pair.first;
-			const ObjManager::ObjToken& tb = tok_pair.second;
+	// 对上帧存在但本帧消失的对触发 Exit 回调（按 key 顺序；Unregister 已处理过的对跳过）
+	for (uint32_t idx : exit_pairs_) {
+		if (prev_collision_pairs_[idx].removed) continue;
+		const ObjManager::ObjToken& ta = prev_collision_pairs_[idx].first;
+		const ObjManager::ObjToken& tb = prev_collision_pairs_[idx].second;
 
-			if (!ObjManager::Instance().IsValid(ta) || !ObjManager::Instance().IsValid(tb)) continue;
+		if (!objs.IsValid(ta) || !objs.IsValid(tb)) continue;
 
-			// 使用 operator[] 获取引用（已校验）
-			BaseObject& oa = ObjManager::Instance()[ta];
-			BaseObject& ob = ObjManager::Instance()[tb];
+		// 使用 operator[] 获取引用（已校验）
+		BaseObject& oa = objs[ta];
+		BaseObject& ob = objs[tb];
 
 #if COLLISION_DEBUG
-			// Exit 只打印简短摘要
-			OUTPUT({"Physics"}, "Collision EXIT: a =", ta.index, "b =", tb.index);
+		// Exit 只打印简短摘要
+		OUTPUT({"Physics"}, "Collision EXIT: a =", ta.index, "b =", tb.index);
 #endif
 
-			oa.OnCollisionState(tb, CF_Manifold{}, BaseObject::CollisionPhase::Exit);
-			ob.OnCollisionState(ta, CF_Manifold{}, BaseObject::CollisionPhase::Exit);
-		}
+		oa.OnCollisionState(tb, CF_Manifold{}, BaseObject::CollisionPhase::Exit);
+		ob.OnCollisionState(ta, CF_Manifold{}, BaseObject::CollisionPhase::Exit);
 	}
 	prev_collision_pairs_.swap(current_pairs_);
-}
\ No newline at end of file
+
+	// 为每个物体串起本帧活跃接触的链表（头插，下标指向 prev_collision_pairs_），供 Unregister 只访问自身的对
+	// - 头指针以 frame_stamp_ 懒失效：本帧首次挂接时才重置，不接触任何对象的物体无需处理
+	auto link = [this](BasePhysics& body, uint32_t idx, uint32_t& next) {
+		if (body.contact_stamp_ != frame_stamp_) {
+			body.contact_stamp_ = frame_stamp_;
+			body.contact_head_ = NO_CONTACT;
+		}
+		next = body.contact_head_;
+		body.contact_head_ = idx;
+	};
+	for (uint32_t i = 0; i < static_cast<uint32_t>(prev_collision_pairs_.size()); ++i) {
+		ActivePair& ap = prev_collision_pairs_[i];
+		link(objs[ap.first], i, ap.next_first);
+		link(objs[ap.second], i, ap.next_second);
+	}
+}
+
+// 连续碰撞：对每个开启 CCD 的运动条目，在其候选对中寻找本帧位移内最早接触的 SOLID 对象
+// - 目标固定在本帧终点，条目沿相对位移（自身速度减去目标速度）扫掠，因此移动方块同样适用
+// - 命中时把条目放到接触处再前进 CONTINUOUS_SKIN，随后的 narrowphase 会以极小的穿透深度报告该接触
+void PhysicsSystem::resolve_continuous() noexcept
+{
+	stats_.continuous_bodies = continuous_bodies_.size();
+	continuous_slot_.assign(dynamic_entries_.size(), -1);
+	continuous_hits_.assign(continuous_bodies_.size(), ContinuousHit{});
+	for (size_t k = 0; k < continuous_bodies_.size(); ++k) {
+		continuous_slot_[continuous_bodies_[k]] = static_cast<int32_t>(k);
+	}
+
+	auto sweep = [this](uint32_t mover, const Entry& target, const ShapeView& target_shape) {
+		const BasePhysics* tp = target.physics;
+		if (!tp || tp->get_collider_type() != ColliderType::SOLID) return;
+		const BasePhysics* mp = dynamic_entries_[mover].physics;
+		const CF_V2 motion = mp->get_velocity() - tp->get_velocity();
+		if (motion.x == 0.0f && motion.y == 0.0f) return;
+
+		ContinuousHit& best = continuous_hits_[continuous_slot_[mover]];
+		const float toi = sweep_shape_toi(compute_world_shape(mp), motion, target_shape);
+		if (toi >= 0.0f && toi < best.toi) {
+			best.toi = toi;
+			best.motion = motion;
+		}
+	};
+
+	for (const BroadphasePair& pair : pairs_) {
+		if (pair.b & BroadphasePair::STATIC_BIT) {
+			const uint32_t j = pair.b & ~BroadphasePair::STATIC_BIT;
+			if (continuous_slot_[pair.a] >= 0) sweep(pair.a, static_entries_[j], static_shapes_.View(j));
+			continue;
+		}
+		if (continuous_slot_[pair.a] >= 0) sweep(pair.a, dynamic_entries_[pair.b], moving_shapes_.View(pair.b));
+		if (continuous_slot_[pair.b] >= 0) sweep(pair.b, dynamic_entries_[pair.a], moving_shapes_.View(pair.a));
+	}
+
+	for (size_t k = 0; k < continuous_bodies_.size(); ++k) {
+		const ContinuousHit& hit = continuous_hits_[k];
+		if (hit.toi >= 1.0f) continue;
+
+		const uint32_t i = continuous_bodies_[k];
+		BasePhysics* p = dynamic_entries_[i].physics;
+		const float len = v2math::length(hit.motion);
+		const float back = len * (1.0f - hit.toi) - CONTINUOUS_SKIN;
+		if (back <= 0.0f) continue;
+		p->set_position(p->get_position() - hit.motion * (back / len));
+		const CF_ShapeWrapper shape = compute_world_shape(p);
+		moving_shapes_.Set(i, shape, shape_wrapper_to_aabb(shape));
+		p->clear_position_dirty();
+		++stats_.continuous_clamped;
+	}
+}
+
+bool PhysicsSystem::is_resting(uint64_t key, uint64_t version) const noexcept
+{
+	auto sit = static_token_map_.find(key);
+	if (sit != static_token_map_.end()) {
+		const BasePhysics* p = static_entries_[sit->second].physics;
+		return p && p->world_shape_version() == version;
+	}
+	auto dit = dynamic_token_map_.find(key);
+	if (dit == dynamic_token_map_.end()) return false;
+	const BasePhysics* p = dynamic_entries_[dit->second].physics;
+	return p && p->sleeping_ && p->region_active_ && p->world_shape_version() == version;
+}
+
+bool PhysicsSystem::RefreshActivation(BasePhysics& p) noexcept
+{
+	bool active = !has_activation_region_ || p.always_active_;
+	if (!active) {
+		const CF_Aabb box = shape_wrapper_to_aabb(p.get_shape());
+		const CF_Aabb& r = activation_region_;
+		active = box.min.x <= r.max.x && box.max.x >= r.min.x && box.min.y <= r.max.y && box.max.y >= r.min.y;
+	}
+	// 重新激活时唤醒：未激活期间其 world shape 缓存槽位没有更新，不能按休眠体沿用
+	if (active && !p.region_active_) p.wake_up();
+	p.region_active_ = active;
+	return active;
+}
+
+const PhysicsSystem::Entry* PhysicsSystem::resolve_ref(uint32_t ref, const QueryFilter& filter,
+	ShapeView& out_shape) const noexcept
+{
+	const uint32_t idx = ref & ~BroadphasePair::STATIC_BIT;
+	const Entry* e = nullptr;
+	if (ref & BroadphasePair::STATIC_BIT) {
+		if (idx >= static_entries_.size()) return nullptr;
+		e = &static_entries_[idx];
+		out_shape = static_shapes_.View(idx);
+	}
+	else {
+		if (idx >= dynamic_entries_.size() || idx >= moving_shapes_.Size()) return nullptr;
+		e = &dynamic_entries_[idx];
+		out_shape = moving_shapes_.View(idx);
+	}
+
+	const BasePhysics* p = e->physics;
+	if (!p || p->get_collider_type() == ColliderType::VOID) return nullptr;
+	if (!(filter.collider_mask & ColliderMaskOf(p->get_collider_type()))) return nullptr;
+	if (!(filter.layer_mask & p->get_collision_category())) return nullptr;
+	if (e->token == filter.ignore) return nullptr;
+	if (filter.tag != TagRegistry::INVALID) {
+		if (!ObjManager::Instance().IsValid(e->token)) return nullptr;
+		if (!ObjManager::Instance()[e->token].HasTag(filter.tag)) return nullptr;
+	}
+	return e;
+}
+
+void PhysicsSystem::query_overlaps(const CF_ShapeWrapper& shape, const CF_Aabb& bounds,
+	std::vector<ObjManager::ObjToken>& out, const QueryFilter& filter) const
+{
+	query_refs_.clear();
+	broadphase_->QueryAabb(bounds, query_refs_);
+	sort_unique_refs(query_refs_);
+	for (uint32_t ref : query_refs_) {
+		ShapeView other;
+		const Entry* e = resolve_ref(ref, filter, other);
+		if (e && shapes_collide_world(ShapeView::Of(shape), other, nullptr)) out.push_back(e->token);
+	}
+}
+
+void PhysicsSystem::QueryPoint(CF_V2 point, std::vector<ObjManager::ObjToken>& out, const QueryFilter& filter) const
+{
+	CF_Aabb box;
+	box.min = point;
+	box.max = point;
+	query_refs_.clear();
+	broadphase_->QueryAabb(box, query_refs_);
+	sort_unique_refs(query_refs_);
+	for (uint32_t ref : query_refs_) {
+		ShapeView shape;
+		const Entry* e = resolve_ref(ref, filter, shape);
+		if (e && shape_contains_point(shape, point)) out.push_back(e->token);
+	}
+}
+
+void PhysicsSystem::QueryAabb(const CF_Aabb& box, std::vector<ObjManager::ObjToken>& out, const QueryFilter& filter) const
+{
+	query_overlaps(CF_ShapeWrapper::FromAabb(box), box, out, filter);
+}
+
+void PhysicsSystem::QueryCircle(CF_V2 center, float radius, std::vector<ObjManager::ObjToken>& out, const QueryFilter& filter) const
+{
+	CF_Circle c{};
+	c.p = center;
+	c.r = radius;
+	CF_ShapeWrapper shape = CF_ShapeWrapper::FromCircle(c);
+	query_overlaps(shape, shape_wrapper_to_aabb(shape), out, filter);
+}
+
+void PhysicsSystem::QueryShape(const CF_ShapeWrapper& shape, std::vector<ObjManager::ObjToken>& out, const QueryFilter& filter) const
+{
+	query_overlaps(shape, shape_wrapper_to_aabb(shape), out, filter);
+}
+
+void PhysicsSystem::cast_ray(CF_V2 origin, CF_V2 dir, float max_distance, bool all,
+	std::vector<RaycastHit>& out_hits, const QueryFilter& filter) const
+{
+	const CF_V2 d = v2math::normalized(dir);
+	if ((d.x == 0.0f && d.y == 0.0f) || max_distance <= 0.0f) return;
+
+	query_refs_.clear();
+	broadphase_->QueryRay(origin, d, max_distance, query_refs_);
+	sort_unique_refs(query_refs_);
+
+	const size_t first = out_hits.size();
+	CF_Ray ray{};
+	ray.p = origin;
+	ray.d = d;
+	ray.t = max_distance;
+	for (uint32_t ref : query_refs_) {
+		ShapeView shape;
+		const Entry* e = resolve_ref(ref, filter, shape);
+		if (!e || !shape.data) continue;
+		CF_Raycast rc{};
+		if (!cf_cast_ray(ray, shape.data, nullptr, shape.type, &rc)) continue;
+		if (rc.t < 0.0f || rc.t > ray.t) continue;
+
+		RaycastHit hit;
+		hit.token = e->token;
+		hit.distance = rc.t;
+		hit.point = origin + d * rc.t;
+		hit.normal = rc.n;
+		if (all) {
+			out_hits.push_back(hit);
+			continue;
+		}
+		// 只保留最近命中：缩短射线，后续候选只接受更近的命中
+		ray.t = rc.t;
+		if (out_hits.size() == first) out_hits.push_back(hit);
+		else out_hits[first] = hit;
+	}
+
+	if (all) {
+		std::sort(out_hits.begin() + first, out_hits.end(), [](const RaycastHit& l, const RaycastHit& r) {
+			return l.distance < r.distance;
+		});
+	}
+}
+
+bool PhysicsSystem::Raycast(CF_V2 origin, CF_V2 dir, float max_distance, RaycastHit& out_hit, const QueryFilter& filter) const
+{
+	query_hits_.clear();
+	cast_ray(origin, dir, max_distance, false, query_hits_, filter);
+	if (query_hits_.empty()) return false;
+	out_hit = query_hits_.front();
+	return true;
+}
+
+void PhysicsSystem::RaycastAll(CF_V2 origin, CF_V2 dir, float max_distance, std::vector<RaycastHit>& out_hits, const QueryFilter& filter) const
+{
+	cast_ray(origin, dir, max_distance, true, out_hits, filter);
+}
+
+size_t PhysicsSystem::GetEstimatedMemoryUsageBytes() const noexcept
+{
+	size_t total = 0;
+	total += dynamic_entries_.capacity() * sizeof(Entry);
+	total += static_entries_.capacity() * sizeof(Entry);
+	total += (dynamic_token_map_.bucket_count() + static_token_map_.bucket_count()) * sizeof(std::pair<uint64_t, size_t>);
+	total += moving_shapes_.GetEstimatedMemoryUsageBytes() + static_shapes_.GetEstimatedMemoryUsageBytes();
+	total += moving_flags_.capacity() + static_flags_.capacity();
+	total += swept_aabbs_.capacity() * sizeof(CF_Aabb) + continuous_bodies_.capacity() * sizeof(uint32_t)
+		+ continuous_slot_.capacity() * sizeof(int32_t) + continuous_hits_.capacity() * sizeof(ContinuousHit);
+	total += (moving_filters_.capacity() + static_filters_.capacity()) * sizeof(CollisionFilter);
+	total += pairs_.capacity() * sizeof(BroadphasePair);
+	total += pair_aabbs_.GetEstimatedMemoryUsageBytes() + pair_overlap_.capacity();
+	total += pair_cache_.size() * (sizeof(PairKey) + sizeof(CachedPair)) + pair_cache_.bucket_count() * sizeof(void*);
+	total += (prev_collision_pairs_.capacity() + current_pairs_.capacity()) * sizeof(ActivePair);
+	total += (dispatch_order_.capacity() + exit_pairs_.capacity()) * sizeof(uint32_t);
+	total += narrow_results_.capacity() * sizeof(CachedPair*) + narrow_jobs_.capacity() * sizeof(NarrowphaseJob);
+	total += query_refs_.capacity() * sizeof(uint32_t);
+	total += query_hits_.capacity() * sizeof(RaycastHit);
+	total += broadphase_->GetEstimatedMemoryUsageBytes();
+	total += events_.capacity() * sizeof(CollisionEvent);
+	total += partition_refresh_queue_.capacity() * sizeof(uint64_t);
+	return total;
+}
@@ -144,6 +144,8 @@ void DrawingSequence::Unregister(BaseObject* obj) noexcept
 {
     if (!obj) return;
     std::lock_guard<std::mutex> lock(m_mutex);
+    // ֮·Ϊգֱӷ
+    if (m_entries.empty()) return;
     auto it = std::find_if(m_entries.begin(), m_entries.end(),
         [obj](const std::unique_ptr<Entry>& entry) {
             return entry->owner == obj;
@@ -162,6 +164,13 @@ void DrawingSequence::Unregister(BaseObject* obj) noexcept
         "reg_index=", reg_index);
 }
 
+void DrawingSequence::Clear() noexcept
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    OUTPUT(Header{ "DrawingSequence" }, "Cleared entries=", m_entries.size());
+    m_entries.clear();
+}
+
 void DrawingSequence::DrawAll()
 {
     std::lock_guard<std::mutex> lock(m_mutex);
@@ -186,8 +195,8 @@ void DrawingSequence::DrawAll()
             // ˢ¶
             cf_sprite_update(&sprite);
 
-            // ʹöλø transform
-            CF_V2 pos = obj->GetPosition();
+            // ʹöλø transformһ߼뵱ǰλ֮䰴ۼֵ
+            CF_V2 pos = obj->GetRenderPosition(m_interp_alpha);
             sprite.transform.p = pos;
 
             DrawUI::on_draw_ui.add(
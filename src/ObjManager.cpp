@@ -1,5 +1,8 @@
 #include "obj_manager.h"
 #include "base_object.h" // 提供 BaseObject 声明
+#include "drawing_sequence.h"
+#include <algorithm>
+#include <bit>
 #include <typeinfo>
 #include <cstdint>
 #include <stdexcept>
@@ -11,7 +14,7 @@ ObjManager::ObjManager() noexcept = default;
 
 ObjManager::~ObjManager() noexcept
 {
-    // 析构时依赖 unique_ptr 自动释放管理的对象资源
+    // 析构时依赖 ObjPtr 自动把对象归还对象池，随后各对象池释放自身的块
     // 注意：析构前应确保外部不再使用 ObjManager（单例析构顺序依赖）
 }
 
@@ -39,8 +42,9 @@ uint32_t ObjManager::ReserveSlotForCreate() noexcept
         Entry& e = objects_[idx];
         e.ptr.reset();
         e.alive = false;
+        e.pending = false;
         e.skip_update_this_frame = false;
-        // generation 将在 CreateEntry/Delayed 时增加
+        // generation 将在 CreateEntry 中增加
         return idx;
     } else {
         objects_.emplace_back();
@@ -48,10 +52,10 @@ uint32_t ObjManager::ReserveSlotForCreate() noexcept
     }
 }
 
-// 将 unique_ptr<BaseObject> 纳入管理并立即启动（Start），但不直接扩展 objects_；
-// 对象被放入 pending_creates_，在 UpdateAll 的提交阶段合并到 objects_（安全点）。
-// 返回的 token.index 为 pending id（非真实 objects_ 索引），调用方应使用 TryGetRegisteration 查验或等待下一帧提交。
-ObjManager::ObjToken ObjManager::CreateEntry(std::unique_ptr<BaseObject> obj)
+// 将池中构造的对象纳入管理并立即启动（Start），同时在 objects_ 中预留真实槽位；
+// 槽位处于 pending 状态（alive == false，各更新阶段都会跳过），在 UpdateAll 的提交阶段才标记存活（安全点）。
+// 返回的 token 已是提交后的 index/generation，只是 isRegitsered == false，调用方应使用 TryGetRegisteration 查验或等待下一帧提交。
+ObjManager::ObjToken ObjManager::CreateEntry(ObjPtr obj, uint32_t type_id, uint8_t hooks)
 {
     if (!obj) {
         OUTPUT({"ObjManager"}, "CreateEntry: factory returned nullptr");
@@ -59,6 +63,7 @@ ObjManager::ObjToken ObjManager::CreateEntry(std::unique_ptr<BaseObject> obj)
     }   
 
     BaseObject* raw = obj.get();
+    raw->m_update_hooks = hooks;
 
     // 立即调用 Start()，但要注意异常安全：若 Start() 失败需要回滚
     try {
@@ -69,18 +74,23 @@ ObjManager::ObjToken ObjManager::CreateEntry(std::unique_ptr<BaseObject> obj)
         return ObjToken::Invalid();
     }
 
-    // 分配 pending id 并将对象放入 pending 创建区；此时不向 objects_ 添加条目以避免在更新循环中触发 vector 重分配导致迭代器失效。
-    uint32_t pid = next_pending_id_++;
-    pending_creates_.emplace(pid, PendingCreate{ std::move(obj) });
-    pending_ptr_to_id_.emplace(raw, pid);
+    // 预留槽位并把对象放入其中；generation 在此处递增，提交时不再变化，因此 pending token 与真实 token 一致。
+    // 注意：追加槽位可能使 objects_ 重分配，UpdateAll 各阶段在回调之后不再使用先前取得的 Entry 引用。
+    uint32_t index = ReserveSlotForCreate();
+    Entry& e = objects_[index];
+    e.ptr = std::move(obj);
+    e.type_id = type_id;
+    e.hooks = hooks;
+    e.pending = true;
+    ++e.generation;
+
+    ObjToken token{ index, e.generation, false };
+    pending_creates_.push_back(token);
     ++alive_count_;
 
     OUTPUT({"ObjManager"}, "CreateEntry: created pending object at", static_cast<const void*>(raw),
-        " (pending id =", pid, ", commit next-frame)");
+        " (index =", index, ", gen =", e.generation, ", commit next-frame)");
 
-    ObjToken token;
-    token.index = pid;
-	token.isRegitsered = false;
     return token;
 }
 
@@ -102,34 +112,28 @@ void ObjManager::DestroyEntry(uint32_t index) noexcept
     PhysicsSystem::Instance().Unregister(tok);
 
     // 调用对象的销毁钩子以便对象处理自身资源
-    e.ptr->OnDestroy();
+    raw->OnDestroy();
 
-    // 从索引映射中移除
+    // 从索引映射与标签成员表中移除（OnDestroy 中对标签的修改已同步到成员表，这里按最终掩码注销）
     object_index_map_.erase(raw);
+    UnlinkTags(index, raw->m_tag_mask);
 
     // 将对象的 token 设为 Invalid，避免悬挂句柄
-    e.ptr->SetObjToken(ObjToken::Invalid());
+    raw->SetObjToken(ObjToken::Invalid());
 
-    // 释放 unique_ptr 并标记 slot 可复用
-    e.ptr.reset();
-    e.alive = false;
-    e.skip_update_this_frame = false;
+    // 回调中可能创建了新对象并使 objects_ 重分配，这里重新取得条目
+    Entry& slot = objects_[index];
 
-    // 增加 generation 使旧 token 失效（保证安全回收）
-    ++e.generation;
+    // 释放 unique_ptr 并标记 slot 可复用
+    slot.ptr.reset();
+    slot.alive = false;
+    slot.skip_update_this_frame = false;
 
-    // 修复：清理 pending -> real 映射时，需同时检查 index 和 generation
-    for (auto it = pending_to_real_map_.begin(); it != pending_to_real_map_.end(); ) {
-        if (it->second.index == index && it->second.generation == (e.generation - 1)) {
-            OUTPUT({"ObjManager"}, "DestroyEntry: removing pending_to_real_map_ entry for pending id =",
-                      it->first, "-> index=", index, ", gen=", (e.generation - 1));
-            it = pending_to_real_map_.erase(it);
-        } else {
-            ++it;
-        }
-    }
+    // 增加 generation 使旧 token（包括创建时返回的 pending token）失效（保证安全回收）
+    ++slot.generation;
 
     free_indices_.push_back(index);
+    update_order_dirty_ = true;
 
     if (alive_count_ > 0) --alive_count_;
 }
@@ -160,24 +164,28 @@ void ObjManager::DestroyExisting(const ObjToken& token) noexcept
     }
 }
 
-// 如果传入的 token 对应 pending 对象且尚未被合并为真实 token，则直接销毁 pending 记录并调用 OnDestroy
+// 如果传入的 token 对应 pending 对象且尚未被合并为真实 token，则直接销毁 pending 对象并调用 OnDestroy，预留槽立即归还
+// - pending_creates_ 中对应的记录留到提交阶段，因 generation 不匹配而被跳过
 void ObjManager::DestroyPending(const ObjToken& p) noexcept
 {
-    if (!p.isValid()) return;
-    if (TryGetRegisteration(p)) return;
+    if (!p.isValid() || p.index >= objects_.size()) return;
+    const Entry& e = objects_[p.index];
+    if (!e.pending || e.generation != p.generation || !e.ptr) return;
 
-    auto it = pending_creates_.find(p.index);
-    if (it == pending_creates_.end()) return;
-    BaseObject* raw = it->second.ptr.get();
+    BaseObject* raw = e.ptr.get();
     // 调用 OnDestroy 让对象清理自身资源
-    it->second.ptr->OnDestroy();
+    raw->OnDestroy();
     // 若意外存在 token，置为 Invalid（通常 pending 对象尚未被赋 token）
-    it->second.ptr->SetObjToken(ObjToken::Invalid());
-    // 移除 pending 记录
-    pending_creates_.erase(it);
-    pending_ptr_to_id_.erase(raw);
+    raw->SetObjToken(ObjToken::Invalid());
+
+    // OnDestroy 中可能创建了新对象并使 objects_ 重分配，这里重新取得条目
+    Entry& slot = objects_[p.index];
+    slot.ptr.reset();
+    slot.pending = false;
+    ++slot.generation;
+    free_indices_.push_back(p.index);
     if (alive_count_ > 0) --alive_count_;
-    OUTPUT({"ObjManager"}, "DestroyPending: destroyed pending id =", p.index, "at", static_cast<const void*>(raw));
+    OUTPUT({"ObjManager"}, "DestroyPending: destroyed pending object at index =", p.index, "at", static_cast<const void*>(raw));
 }
 
 // 高层销毁入口：根据传入 token 判定是 pending 还是已注册 token，然后选择合适的路径
@@ -198,70 +206,81 @@ void ObjManager::DestroyAll() noexcept
 {
     OUTPUT({"ObjManager"}, "DestroyAll: destroying all objects (", alive_count_, ")");
 
-    // 清理所有挂起的创建/销毁队列（先清理 pending 表，避免后续提交）
+    // 清理所有挂起的销毁队列（pending 创建的对象位于 objects_ 的预留槽中，随下面的容器清理一并释放）
     pending_destroys_.clear();
     pending_destroy_set_.clear();
-    pending_creates_.clear();
-    pending_ptr_to_id_.clear();
-    pending_to_real_map_.clear();
 
-    // 先从物理系统统一反注册所有仍然存活的对象
-    for (uint32_t i = 0; i < objects_.size(); ++i) {
-        Entry& e = objects_[i];
-        if (e.alive && e.ptr) {
-            PhysicsSystem::Instance().Unregister(ObjToken{ i, e.generation });
-        }
-    }
+    // 整体销毁：物理系统与绘制序列各清空一次（不派发 Exit，也不再逐个反注册/逐个查表），
+    // 之后只剩对象的 OnDestroy + 析构扫描
+    PhysicsSystem::Instance().Clear();
+    DrawingSequence::Instance().Clear();
 
     // 调用 OnDestroy 并彻底释放所有对象资源，使 token 失效
+    // （OnDestroy 中创建的对象会追加到 objects_ 末尾，因此每次回调后按下标重新取得条目）
     for (uint32_t i = 0; i < objects_.size(); ++i) {
-        Entry& e = objects_[i];
-        if (e.alive && e.ptr) {
-            e.ptr->OnDestroy();
+        if (objects_[i].alive && objects_[i].ptr) {
+            BaseObject* raw = objects_[i].ptr.get();
+            raw->OnDestroy();
             // 置 token 为 Invalid
-            e.ptr->SetObjToken(ObjToken::Invalid());
-            object_index_map_.erase(e.ptr.get());
-            e.ptr.reset();
-            e.alive = false;
-            e.skip_update_this_frame = false;
-            ++e.generation; // 使旧 token 失效
-            free_indices_.push_back(i);
+            raw->SetObjToken(ObjToken::Invalid());
+            objects_[i].ptr.reset();
         }
     }
 
-    // 清理容器，重置计数
+    // 清理容器，重置计数（尚未提交的 pending 对象在此释放，不调用 OnDestroy）
+    pending_creates_.clear();
     objects_.clear();
     free_indices_.clear();
     object_index_map_.clear();
+    update_order_.clear();
+    update_order_dirty_ = false;
+    for (auto& members : tag_members_) members.clear();
     alive_count_ = 0;
 }
 
+void ObjManager::BeginStep() noexcept
+{
+    // 区域外冻结的对象同样记录：ActSeq 仍可能移动它们
+    for (size_t i = 0; i < objects_.size(); ++i) {
+        Entry& e = objects_[i];
+        if (e.alive && e.ptr) e.ptr->StepBeginApply();
+    }
+}
+
 void ObjManager::UpdateAll() noexcept
 {
     // 1) 应用物理更新：为每个活跃对象调用 FrameEnterApply()
     // 使用索引遍历以避免持有范围 for 中的引用而在并发修改/重分配时失效
+    // 同时按 PhysicsSystem 的激活区域刷新激活状态：区域外的对象本帧跳过 1)/3)/4) 三个阶段，Step 也不再处理它们
+    PhysicsSystem& physics = PhysicsSystem::Instance();
     for (size_t i = 0; i < objects_.size(); ++i) {
         Entry& e = objects_[i];
-        if (e.alive && e.ptr && !e.skip_update_this_frame) { 
+        if (!e.alive || !e.ptr) continue;
+        if (physics.RefreshActivation(*e.ptr) && !e.skip_update_this_frame) {
             e.ptr->FrameEnterApply(); 
         }
     }
 
     // 2) 全局碰撞检测与回调（PhysicsSystem::Step 会触发对象的碰撞回调）
-    PhysicsSystem::Instance().Step();
+    physics.Step();
 
     // 3) 每帧为活跃对象调用 Update()
-    for (size_t i = 0; i < objects_.size(); ++i) {
-        Entry& e = objects_[i];
-        if (e.alive && e.ptr && !e.skip_update_this_frame) { 
-            e.ptr->Update(); 
+    // 只遍历重写了 Update 的对象，并按类型分组：同一类型的对象连续调用同一个虚函数实现，
+    // 地砖、血迹等没有逐帧逻辑的对象不再进入这一阶段。顺序表只在对象集合变化后重建
+    if (update_order_dirty_) RebuildUpdateOrder();
+    for (size_t i = 0; i < update_order_.size(); ++i) {
+        uint32_t idx = update_order_[i];
+        if (idx >= objects_.size()) continue;
+        Entry& e = objects_[idx];
+        if (e.alive && e.ptr && !e.skip_update_this_frame && e.ptr->is_region_active()) {
+            e.ptr->Update();
         }
     }
 
 	// 4) 帧尾应用：为每个活跃对象调用 FrameExitApply()
     for (size_t i = 0; i < objects_.size(); ++i) {
         Entry& e = objects_[i];
-        if (e.alive && e.ptr && !e.skip_update_this_frame) {
+        if (e.alive && e.ptr && !e.skip_update_this_frame && e.ptr->is_region_active()) {
             e.ptr->FrameExitApply();
         }
     }
@@ -291,75 +310,59 @@ void ObjManager::UpdateAll() noexcept
         pending_destroy_set_.clear();
     }
 
-    // 6) 提交本帧 pending 的创建：在安全点把 pending_creates_ 合并到 objects_ 并注册物理系统，
-    //    使其在下一帧参与 FrameEnterApply / Update / 物理处理。
+    // 6) 提交本帧 pending 的创建：在安全点把预留槽标记为存活并注册物理系统，
+    //    使其在下一帧参与 FrameEnterApply / Update / 物理处理。槽位与 generation 在创建时已确定，这里不再分配。
     if (!pending_creates_.empty()) {
-        // 预留容量以避免在合并过程中发生多次重分配
-        objects_.reserve(objects_.size() + pending_creates_.size());
-
-        // 收集 pending id 列表，避免在循环中修改 unordered_map 导致迭代问题
-        std::vector<uint32_t> pids;
-        pids.reserve(pending_creates_.size());
-        for (const auto &kv : pending_creates_) pids.push_back(kv.first);
-
-        for (uint32_t pid : pids) {
-            auto it = pending_creates_.find(pid);
-            if (it == pending_creates_.end()) continue;
-            PendingCreate &pc = it->second;
-            if (!pc.ptr) {
-                pending_creates_.erase(it);
-                continue;
-            }
-
-            BaseObject* raw = pc.ptr.get();
-            uint32_t index = 0;
-            // 复用空闲 slot 或在末尾追加
-            if (!free_indices_.empty()) {
-                index = free_indices_.back();
-                free_indices_.pop_back();
-                Entry& e = objects_[index];
-                e.ptr = std::move(pc.ptr);
-                e.alive = true;
-                ++e.generation;
-                // 合并到 objects_ 后应在下一帧参与更新，因此这里不设置 skip
-                e.skip_update_this_frame = false;
-            } else {
-                objects_.emplace_back();
-                index = static_cast<uint32_t>(objects_.size() - 1);
-                Entry& e = objects_[index];
-                e.ptr = std::move(pc.ptr);
-                e.alive = true;
-                ++e.generation;
-                e.skip_update_this_frame = false;
-            }
+        PhysicsSystem& physics = PhysicsSystem::Instance();
+        for (size_t i = 0; i < pending_creates_.size(); ++i) {
+            const ObjToken pt = pending_creates_[i];
+            if (pt.index >= objects_.size()) continue;
+            Entry& e = objects_[pt.index];
+            // 提交前已被 DestroyPending 的对象：槽已归还（可能已被复用），generation 不再匹配
+            if (!e.pending || e.generation != pt.generation || !e.ptr) continue;
+
+            e.pending = false;
+            e.alive = true;
+            // 合并到 objects_ 后应在下一帧参与更新，因此这里不设置 skip
+            e.skip_update_this_frame = false;
 
             // 注册索引映射并注册到物理系统
-            object_index_map_[raw] = index;
-            ObjManager::ObjToken tok{ index, objects_[index].generation, true };
-            PhysicsSystem::Instance().Register(tok, raw);
+            BaseObject* raw = e.ptr.get();
+            object_index_map_[raw] = pt.index;
+            ObjManager::ObjToken tok{ pt.index, pt.generation, true };
+            physics.Register(tok, raw);
 
             // 将真实 token 写入对象（ObjManager 为 friend，允许调用 private SetObjToken）
-            if (objects_[index].ptr) {
-                objects_[index].ptr->SetObjToken(tok);
-            }
-
-            // 记录 pending -> real 的映射，便于 ResolvePending
-            pending_to_real_map_.emplace(pid, tok);
-
-            // 从 pending_ptr_to_id_ 中移除
-            pending_ptr_to_id_.erase(raw);
+            // 此后对象上的 AddTag/RemoveTag 会直接同步到标签成员表
+            raw->SetObjToken(tok);
+            LinkTags(pt.index, raw->m_tag_mask);
 
             OUTPUT({"ObjManager"}, "UpdateAll: committed pending object at", static_cast<const void*>(raw),
-                " (type: ", typeid(*objects_[index].ptr).name(), ", pending id =", pid, ", index =", index, ", gen =", objects_[index].generation, ")");
-
-            // 从 pending_creates_ 中移除该条目
-            pending_creates_.erase(it);
+                " (type: ", typeid(*raw).name(), ", index =", pt.index, ", gen =", pt.generation, ")");
         }
+        pending_creates_.clear();
+        update_order_dirty_ = true;
     }
-    
 }
 
 
+// 重建 Update 阶段的遍历顺序：收集重写了 Update 的存活对象，按 (类型, 索引) 排序
+// - 类型内部保持索引升序，因此同类对象之间的相对调用顺序与按索引遍历时一致
+void ObjManager::RebuildUpdateOrder() noexcept
+{
+    update_order_.clear();
+    for (uint32_t i = 0; i < objects_.size(); ++i) {
+        const Entry& e = objects_[i];
+        if (e.alive && e.ptr && (e.hooks & UpdateHooks::UPDATE)) update_order_.push_back(i);
+    }
+    std::sort(update_order_.begin(), update_order_.end(), [this](uint32_t a, uint32_t b) {
+        const uint32_t ta = objects_[a].type_id;
+        const uint32_t tb = objects_[b].type_id;
+        return ta != tb ? ta < tb : a < b;
+    });
+    update_order_dirty_ = false;
+}
+
 // 尝试将 pending token 转换为真实 token，若成功则更新 token 并返回 true，否则返回 false
 // - 非 const 版本会修改输入 token（将其替换为真实 token）
 // - 若 token.isRegitsered == true，则会尝试验证并在不合法时将 token 置为 Invalid
@@ -378,11 +381,13 @@ bool ObjManager::TryGetRegisteration(ObjToken& token) const noexcept
         return false;
     }
 
-    // 尚未标记为 registered：检查 pending -> real 映射表
-    auto it = pending_to_real_map_.find(token.index);
-    if (it != pending_to_real_map_.end()) {
-        token = it->second;
-        return true;
+    // 尚未标记为 registered：pending token 与真实 token 指向同一槽位，槽已提交即可直接升级
+    if (token.index < objects_.size()) {
+        const Entry& e = objects_[token.index];
+        if (e.alive && e.generation == token.generation && e.ptr) {
+            token.isRegitsered = true;
+            return true;
+        }
     }
     return false;
 }
@@ -398,24 +403,27 @@ bool ObjManager::TryGetRegisteration(const ObjToken& token) const noexcept
         return false;
     }
 
-    // 尚未标记为 registered：检查 pending -> real 映射表（只检查，不修改）
-    auto it = pending_to_real_map_.find(token.index);
-    if (it != pending_to_real_map_.end()) return true;
+    // 尚未标记为 registered：检查 token 指向的槽是否已提交（只检查，不修改）
+    if (token.index < objects_.size()) {
+        const Entry& e = objects_[token.index];
+        return (e.alive && e.generation == token.generation && e.ptr);
+    }
     return false;
 }
 
 // operator[] 实现，若 token 为 pending，则尝试转换为真实 token或直接访问 pending 对象
-// - 非 const 版本在遇到 pending token 时会优先查找 pending_creates_，若存在直接返回对应对象（未合并状态）
+// - 非 const 版本在遇到 pending token 时会先检查其预留槽，若仍处于 pending 直接返回对应对象（未合并状态）
 // - 否则尝试 TryGetRegisteration 更新 token（若 pending 已被提交）
 // - 最终将调用 const 版本以进行 bounds/validity 校验并返回引用
 BaseObject& ObjManager::operator[](ObjToken& token)
 {
     if (!token.isRegitsered) {
-		auto it = pending_creates_.find(token.index);
-        if (it != pending_creates_.end()) {
-			BaseObject* raw = it->second.ptr.get();
-			OUTPUT({"ObjManager"}, "operator[]: accessing pending object at", static_cast<const void*>(raw));
-			return *raw;
+        if (token.index < objects_.size()) {
+            Entry& e = objects_[token.index];
+            if (e.pending && e.generation == token.generation && e.ptr) {
+                OUTPUT({"ObjManager"}, "operator[]: accessing pending object at", static_cast<const void*>(e.ptr.get()));
+                return *e.ptr;
+            }
         }
         // 尝试使用 TryGetRegisteration 更新 token（若 pending 已被提交）
         TryGetRegisteration(token);
@@ -443,11 +451,12 @@ BaseObject& ObjManager::operator[](const ObjToken& token)
 const BaseObject& ObjManager::operator[](ObjToken& token) const
 {
     if (!token.isRegitsered) {
-        auto it = pending_creates_.find(token.index);
-        if (it != pending_creates_.end()) {
-            BaseObject* raw = it->second.ptr.get();
-            OUTPUT({"ObjManager"}, "operator[]: accessing pending object at", static_cast<const void*>(raw));
-            return *raw;
+        if (token.index < objects_.size()) {
+            const Entry& e = objects_[token.index];
+            if (e.pending && e.generation == token.generation && e.ptr) {
+                OUTPUT({"ObjManager"}, "operator[]: accessing pending object at", static_cast<const void*>(e.ptr.get()));
+                return *e.ptr;
+            }
         }
         // 尝试使用 TryGetRegisteration 更新 token（若 pending 已被提交）
 		TryGetRegisteration(token);
@@ -470,22 +479,56 @@ const BaseObject& ObjManager::operator[](const ObjToken& token) const
     return *e.ptr;
 }
 
-// 按 tag 查询对象（找到含有对应Tag的第一个物体），并返回 token
-ObjManager::ObjToken ObjManager::FindTokensByTag(const std::string& tag) const noexcept
+// 把 index 登记到 mask 中每个标签的成员表
+void ObjManager::LinkTags(uint32_t index, TagRegistry::Mask mask)
+{
+    while (mask) {
+        const size_t tag = static_cast<size_t>(std::countr_zero(mask));
+        mask &= mask - 1;
+        if (tag >= tag_members_.size()) tag_members_.resize(tag + 1);
+        tag_members_[tag].push_back(index);
+    }
+}
+
+// 从 mask 中每个标签的成员表里移除 index（只扫描该标签的成员，与末尾交换后弹出）
+void ObjManager::UnlinkTags(uint32_t index, TagRegistry::Mask mask) noexcept
+{
+    while (mask) {
+        const size_t tag = static_cast<size_t>(std::countr_zero(mask));
+        mask &= mask - 1;
+        if (tag >= tag_members_.size()) continue;
+        std::vector<uint32_t>& members = tag_members_[tag];
+        auto it = std::find(members.begin(), members.end(), index);
+        if (it == members.end()) continue;
+        *it = members.back();
+        members.pop_back();
+    }
+}
+
+// 按 tag 查询对象（成员表中 index 最小的一个，与原先按 index 顺序扫描得到的结果一致），并返回 token
+ObjManager::ObjToken ObjManager::FindTokensByTag(TagId tag) const noexcept
 {
     ObjToken out;
-    for (uint32_t i = 0; i < objects_.size(); ++i) {
+    if (tag >= tag_members_.size()) return out;
+    for (uint32_t i : tag_members_[tag]) {
+        if (out.isValid() && out.index < i) continue;
         const Entry& e = objects_[i];
         if (!e.alive || !e.ptr) continue;
-        // 直接调用 BaseObject::HasTag（noexcept）
-        if (e.ptr->HasTag(tag)) {
-            out = ObjToken( i, e.generation, true );
-            break;
-        }
+        out = ObjToken( i, e.generation, true );
     }
     return out;
 }
 
+// 按 tag 查询全部对象，结果追加到 out
+void ObjManager::FindAllTokensByTag(TagId tag, std::vector<ObjToken>& out) const
+{
+    if (tag >= tag_members_.size()) return;
+    for (uint32_t i : tag_members_[tag]) {
+        const Entry& e = objects_[i];
+        if (e.alive && e.ptr) out.push_back(ObjToken( i, e.generation, true ));
+    }
+}
+
 size_t ObjManager::GetEstimatedMemoryUsageBytes() const noexcept
 {
     size_t total = 0;
@@ -493,9 +536,14 @@ size_t ObjManager::GetEstimatedMemoryUsageBytes() const noexcept
     total += free_indices_.capacity() * sizeof(uint32_t);
     total += pending_destroys_.capacity() * sizeof(ObjToken);
     total += pending_destroy_set_.bucket_count() * sizeof(decltype(pending_destroy_set_)::value_type);
-    total += pending_creates_.bucket_count() * sizeof(decltype(pending_creates_)::value_type);
-    total += pending_ptr_to_id_.bucket_count() * sizeof(decltype(pending_ptr_to_id_)::value_type);
-    total += pending_to_real_map_.bucket_count() * sizeof(decltype(pending_to_real_map_)::value_type);
+    total += pending_creates_.capacity() * sizeof(ObjToken);
     total += object_index_map_.bucket_count() * sizeof(decltype(object_index_map_)::value_type);
+    total += update_order_.capacity() * sizeof(uint32_t);
+    total += tag_members_.capacity() * sizeof(std::vector<uint32_t>);
+    for (const auto& members : tag_members_) total += members.capacity() * sizeof(uint32_t);
+    total += pools_.capacity() * sizeof(std::unique_ptr<ObjectPoolBase>);
+    for (const auto& pool : pools_) {
+        if (pool) total += pool->GetEstimatedMemoryUsageBytes();
+    }
     return total;
 }
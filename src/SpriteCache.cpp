@@ -0,0 +1,75 @@
+#include "sprite_cache.h"
+#include "debug_config.h"
+
+SpriteCache& SpriteCache::Instance() noexcept
+{
+    static SpriteCache inst;
+    return inst;
+}
+
+// 命中缓存时仅做一次哈希查找与 CF_Sprite 拷贝；未命中时才真正触发文件 I/O 与 PNG 解码
+bool SpriteCache::Acquire(const std::string& path, CF_Sprite& out) noexcept
+{
+    if (path.empty()) return false;
+
+    auto it = entries_.find(path);
+    if (it == entries_.end()) {
+        CF_Sprite sprite = cf_make_easy_sprite_from_png(path.c_str(), nullptr);
+        if (!sprite.easy_sprite_id) {
+            OUTPUT({ "SpriteCache" }, "Failed to load sprite:", path.c_str());
+            return false;
+        }
+        it = entries_.emplace(path, Entry{ sprite, 0 }).first;
+        OUTPUT({ "SpriteCache" }, "Decoded sprite:", path.c_str(), "(cached entries =", entries_.size(), ")");
+    }
+
+    ++it->second.ref_count;
+    out = it->second.sprite;
+    return true;
+}
+
+void SpriteCache::Release(const std::string& path) noexcept
+{
+    auto it = entries_.find(path);
+    if (it == entries_.end()) {
+        OUTPUT({ "SpriteCache" }, "Release skipped (not cached):", path.c_str());
+        return;
+    }
+    if (it->second.ref_count > 0) --it->second.ref_count;
+}
+
+size_t SpriteCache::TrimUnused() noexcept
+{
+    size_t removed = 0;
+    for (auto it = entries_.begin(); it != entries_.end(); ) {
+        if (it->second.ref_count == 0) {
+            cf_easy_sprite_unload(&it->second.sprite);
+            it = entries_.erase(it);
+            ++removed;
+        }
+        else {
+            ++it;
+        }
+    }
+    OUTPUT({ "SpriteCache" }, "TrimUnused: unloaded", removed, "entries, remaining =", entries_.size());
+    return removed;
+}
+
+void SpriteCache::Clear() noexcept
+{
+    for (auto& kv : entries_) {
+        if (kv.second.ref_count > 0) {
+            OUTPUT({ "SpriteCache" }, "Clear: entry still referenced:", kv.first.c_str(), "refs =", kv.second.ref_count);
+        }
+        cf_easy_sprite_unload(&kv.second.sprite);
+    }
+    entries_.clear();
+}
+
+size_t SpriteCache::GetEstimatedMemoryUsageBytes() const noexcept
+{
+    size_t total = 0;
+    total += entries_.bucket_count() * sizeof(decltype(entries_)::value_type);
+    for (const auto& kv : entries_) total += kv.first.capacity();
+    return total;
+}
@@ -0,0 +1,46 @@
+#include "tag_registry.h"
+#include "debug_config.h"
+
+TagRegistry& TagRegistry::Instance() noexcept
+{
+    static TagRegistry inst;
+    return inst;
+}
+
+TagId TagRegistry::Intern(const std::string& name) noexcept
+{
+    auto it = ids_.find(name);
+    if (it != ids_.end()) return it->second;
+
+    if (names_.size() >= kMaxTags) {
+        OUTPUT({ "TagRegistry" }, "Intern: tag limit reached, ignoring tag:", name.c_str());
+        return INVALID;
+    }
+
+    const TagId id = static_cast<TagId>(names_.size());
+    names_.push_back(name);
+    ids_.emplace(name, id);
+    OUTPUT({ "TagRegistry" }, "Intern: registered tag", name.c_str(), "as id", static_cast<int>(id));
+    return id;
+}
+
+TagId TagRegistry::Find(const std::string& name) const noexcept
+{
+    auto it = ids_.find(name);
+    return it != ids_.end() ? it->second : INVALID;
+}
+
+const std::string& TagRegistry::Name(TagId id) const noexcept
+{
+    static const std::string empty;
+    return id < names_.size() ? names_[id] : empty;
+}
+
+size_t TagRegistry::GetEstimatedMemoryUsageBytes() const noexcept
+{
+    size_t total = sizeof(*this);
+    total += ids_.bucket_count() * sizeof(decltype(ids_)::value_type);
+    total += names_.capacity() * sizeof(std::string);
+    for (const auto& n : names_) total += n.capacity();
+    return total;
+}
@@ -0,0 +1,89 @@
+#include "worker_pool.h"
+
+void WorkerPool::Resize(size_t threads)
+{
+#ifdef __EMSCRIPTEN__
+	threads = 0;
+#endif
+	if (threads == threads_.size()) return;
+
+	// 先停止全部现有线程，再按新数量重新创建（只在初始化/配置变更时发生）
+	if (!threads_.empty()) {
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stop_ = true;
+		}
+		start_cv_.notify_all();
+		for (std::thread& t : threads_) t.join();
+		threads_.clear();
+		stop_ = false;
+	}
+
+	// 新线程从当前 generation 开始等待：否则在已执行过 ParallelFor 的池里会立即按过期的一轮醒来，
+	// 在没有任务的情况下递减 pending_workers_，与下一次 ParallelFor 的计数交错
+	uint64_t generation = 0;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		generation = generation_;
+	}
+	threads_.reserve(threads);
+	for (size_t i = 0; i < threads; ++i) {
+		threads_.emplace_back([this, generation] { worker_loop(generation); });
+	}
+}
+
+// 领取并执行区间，直到全部区间被领取
+void WorkerPool::run_batches() noexcept
+{
+	for (;;) {
+		const size_t begin = next_.fetch_add(job_batch_, std::memory_order_relaxed);
+		if (begin >= job_count_) return;
+		const size_t end = begin + job_batch_ < job_count_ ? begin + job_batch_ : job_count_;
+		(*job_)(begin, end);
+	}
+}
+
+void WorkerPool::worker_loop(uint64_t seen)
+{
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			start_cv_.wait(lock, [&] { return stop_ || generation_ != seen; });
+			if (stop_) return;
+			seen = generation_;
+		}
+
+		run_batches();
+
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (--pending_workers_ == 0) done_cv_.notify_one();
+	}
+}
+
+void WorkerPool::ParallelFor(size_t count, size_t batch, const std::function<void(size_t, size_t)>& fn)
+{
+	if (count == 0) return;
+	if (batch == 0) batch = 1;
+	if (threads_.empty() || count <= batch) {
+		fn(0, count);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		job_ = &fn;
+		job_count_ = count;
+		job_batch_ = batch;
+		next_.store(0, std::memory_order_relaxed);
+		pending_workers_ = threads_.size();
+		++generation_;
+	}
+	start_cv_.notify_all();
+
+	// 调用线程同样参与领取，随后等待所有工作线程退出本轮
+	run_batches();
+
+	std::unique_lock<std::mutex> lock(mutex_);
+	done_cv_.wait(lock, [&] { return pending_workers_ == 0; });
+	job_ = nullptr;
+}
@@ -0,0 +1,98 @@
+#include "base_physics.h"
+
+uint32_t WorldShapeStore::alloc_slot(CF_ShapeType type)
+{
+	auto take = [](auto& pool, std::vector<uint32_t>& free_list) -> uint32_t {
+		if (!free_list.empty()) {
+			const uint32_t slot = free_list.back();
+			free_list.pop_back();
+			return slot;
+		}
+		pool.emplace_back();
+		return static_cast<uint32_t>(pool.size() - 1);
+	};
+	switch (type) {
+	case CF_SHAPE_TYPE_CIRCLE: return take(circles_, free_circles_);
+	case CF_SHAPE_TYPE_CAPSULE: return take(capsules_, free_capsules_);
+	case CF_SHAPE_TYPE_POLY: return take(polys_, free_polys_);
+	default: return 0;
+	}
+}
+
+void WorldShapeStore::free_slot(CF_ShapeType type, uint32_t slot) noexcept
+{
+	switch (type) {
+	case CF_SHAPE_TYPE_CIRCLE: free_circles_.push_back(slot); break;
+	case CF_SHAPE_TYPE_CAPSULE: free_capsules_.push_back(slot); break;
+	case CF_SHAPE_TYPE_POLY: free_polys_.push_back(slot); break;
+	default: break;
+	}
+}
+
+void WorldShapeStore::retype(size_t i, CF_ShapeType type)
+{
+	const CF_ShapeType old = static_cast<CF_ShapeType>(types_[i]);
+	if (old == type) return;
+	free_slot(old, slots_[i]);
+	slots_[i] = alloc_slot(type);
+	types_[i] = static_cast<uint8_t>(type);
+}
+
+void WorldShapeStore::Resize(size_t count)
+{
+	for (size_t i = count; i < types_.size(); ++i) {
+		free_slot(static_cast<CF_ShapeType>(types_[i]), slots_[i]);
+	}
+	aabbs_.resize(count);
+	types_.resize(count, static_cast<uint8_t>(CF_SHAPE_TYPE_NONE));
+	slots_.resize(count, 0);
+}
+
+void WorldShapeStore::Set(size_t i, const CF_ShapeWrapper& shape, const CF_Aabb& bounds)
+{
+	retype(i, shape.type);
+	aabbs_[i] = bounds;
+	switch (shape.type) {
+	case CF_SHAPE_TYPE_CIRCLE: circles_[slots_[i]] = shape.u.circle; break;
+	case CF_SHAPE_TYPE_CAPSULE: capsules_[slots_[i]] = shape.u.capsule; break;
+	case CF_SHAPE_TYPE_POLY: polys_[slots_[i]] = shape.u.poly; break;
+	default: break;
+	}
+}
+
+void WorldShapeStore::Copy(size_t dst, size_t src)
+{
+	if (dst == src) return;
+	const CF_ShapeType type = static_cast<CF_ShapeType>(types_[src]);
+	retype(dst, type);
+	aabbs_[dst] = aabbs_[src];
+	switch (type) {
+	case CF_SHAPE_TYPE_CIRCLE: circles_[slots_[dst]] = circles_[slots_[src]]; break;
+	case CF_SHAPE_TYPE_CAPSULE: capsules_[slots_[dst]] = capsules_[slots_[src]]; break;
+	case CF_SHAPE_TYPE_POLY: polys_[slots_[dst]] = polys_[slots_[src]]; break;
+	default: break;
+	}
+}
+
+ShapeView WorldShapeStore::View(size_t i) const noexcept
+{
+	const CF_ShapeType type = static_cast<CF_ShapeType>(types_[i]);
+	switch (type) {
+	case CF_SHAPE_TYPE_AABB: return ShapeView{ type, &aabbs_[i] };
+	case CF_SHAPE_TYPE_CIRCLE: return ShapeView{ type, &circles_[slots_[i]] };
+	case CF_SHAPE_TYPE_CAPSULE: return ShapeView{ type, &capsules_[slots_[i]] };
+	case CF_SHAPE_TYPE_POLY: return ShapeView{ type, &polys_[slots_[i]] };
+	default: return ShapeView{};
+	}
+}
+
+size_t WorldShapeStore::GetEstimatedMemoryUsageBytes() const noexcept
+{
+	return aabbs_.capacity() * sizeof(CF_Aabb)
+		+ types_.capacity()
+		+ slots_.capacity() * sizeof(uint32_t)
+		+ circles_.capacity() * sizeof(CF_Circle)
+		+ capsules_.capacity() * sizeof(CF_Capsule)
+		+ polys_.capacity() * sizeof(CF_Poly)
+		+ (free_circles_.capacity() + free_capsules_.capacity() + free_polys_.capacity()) * sizeof(uint32_t);
+}
@@ -1,11 +1,13 @@
 #include "base_object.h"
 #include "drawing_sequence.h" // 在 C++ 文件中引用以便使用 DrawingSequence 接口
+#include "sprite_cache.h"     // 进程级精灵缓存：同一 PNG 只解码一次
 #include "cute_sprite.h"      // 包含以使用 CF_Sprite 和相关函数
 #include <iostream>
 #include <cmath>
 
 // BaseObject 的精灵资源与绘制注册相关逻辑：
 // - SpriteSetSource 在设置新路径时会注册/注销 DrawingSequence 以纳入统一的上传与绘制流程。
+// - 精灵资源通过 SpriteCache 按路径共享，BaseObject 只负责 Acquire/Release，不直接解码或卸载 PNG。
 // - TweakColliderWithPivot 用于在用户改变 pivot 时同步调整碰撞形状。
 
 void BaseObject::SpriteSetStats(const std::string& path, int vertical_frame_count, int update_freq, int depth, bool set_shape_aabb) noexcept
@@ -29,11 +31,14 @@ void BaseObject::SpriteSetSource(const std::string& path, int vertical_frame_cou
         BasePhysics::scale_y(preserved_scale.y);
     };
 
-    // 如果之前有有效的精灵路径，先从绘制序列中注销
-    if (!m_sprite_path.empty()) {
+    // 如果之前有有效的精灵路径（或正在播放片段），先从绘制序列中注销并归还缓存引用
+    if (!m_sprite_path.empty() || m_sprite_clip_index >= 0) {
         DrawingSequence::Instance().Unregister(this);
-        cf_easy_sprite_unload(&m_sprite);
     }
+    if (!m_sprite_path.empty()) {
+        SpriteCache::Instance().Release(m_sprite_path);
+    }
+    m_sprite_clip_index = -1;
 
     // 更新路径和帧数
     m_sprite_path = path;
@@ -47,11 +52,10 @@ void BaseObject::SpriteSetSource(const std::string& path, int vertical_frame_cou
         return;
     }
 
-    // 始终使用 cf_make_easy_sprite_from_png 加载 PNG 文件。
+    // 通过 SpriteCache 获取 PNG：首次使用时由缓存调用 cf_make_easy_sprite_from_png 解码，之后直接共享同一纹理。
     // cute_sprite 将整个文件加载为单个大图像。
     // 多帧动画的分割逻辑需要由您的渲染器（DrawingSequence）根据 m_sprite_vertical_frame_count 处理。
-    m_sprite = cf_make_easy_sprite_from_png(m_sprite_path.c_str(), nullptr);
-    if (!m_sprite.easy_sprite_id) {
+    if (!SpriteCache::Instance().Acquire(m_sprite_path, m_sprite)) {
         OUTPUT({ "Sprite" }, "Failed to load sprite:", m_sprite_path.c_str());
         m_sprite = cf_sprite_defaults();
         restore_scale();
@@ -81,6 +85,69 @@ void BaseObject::SpriteSetUpdateFreq(int update_freq) noexcept
 	m_sprite_update_freq = update_freq > 0 ? update_freq : 1;
 }
 
+int BaseObject::SpriteAddClip(const std::string& name, const std::string& path, int vertical_frame_count, int update_freq) noexcept
+{
+    // 同名片段直接返回已有索引，避免重复持有缓存引用
+    int existing = SpriteFindClip(name);
+    if (existing >= 0) return existing;
+
+    SpriteClip clip;
+    if (!SpriteCache::Instance().Acquire(path, clip.sprite)) {
+        OUTPUT({ "Sprite" }, "Failed to load clip:", name.c_str(), "path:", path.c_str());
+        return -1;
+    }
+    clip.name = name;
+    clip.path = path;
+    clip.vertical_frame_count = vertical_frame_count > 0 ? vertical_frame_count : 1;
+    clip.update_freq = update_freq > 0 ? update_freq : 1;
+    m_sprite_clips.push_back(std::move(clip));
+    return static_cast<int>(m_sprite_clips.size() - 1);
+}
+
+int BaseObject::SpriteFindClip(const std::string& name) const noexcept
+{
+    for (size_t i = 0; i < m_sprite_clips.size(); ++i) {
+        if (m_sprite_clips[i].name == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+// 片段切换只改写纹理句柄、尺寸与帧参数：保留当前 transform/scale/opacity，并按新尺寸重算 pivot 的渲染偏移。
+// 与 SpriteSetSource 不同，这里不触及 DrawingSequence 注册与 SpriteCache 引用计数（片段引用在 SpriteAddClip 时已持有）。
+bool BaseObject::SpritePlayClip(int index) noexcept
+{
+    if (index < 0 || index >= static_cast<int>(m_sprite_clips.size())) return false;
+    if (index == m_sprite_clip_index) return true;
+
+    const bool registered = !m_sprite_path.empty() || m_sprite_clip_index >= 0;
+
+    // 从普通精灵切入片段模式：归还 SpriteSetSource 持有的引用
+    if (!m_sprite_path.empty()) {
+        SpriteCache::Instance().Release(m_sprite_path);
+        m_sprite_path.clear();
+    }
+
+    const SpriteClip& clip = m_sprite_clips[index];
+    CF_Sprite next = clip.sprite;
+    next.transform = m_sprite.transform;
+    next.scale = m_sprite.scale;
+    next.opacity = m_sprite.opacity;
+    float hw = next.w / 2.0f;
+    float hh = next.h / static_cast<float>(clip.vertical_frame_count) / 2.0f;
+    next.offset = -CF_V2{ m_pivot.x * hw, m_pivot.y * hh };
+    m_sprite = next;
+
+    m_sprite_vertical_frame_count = clip.vertical_frame_count;
+    m_sprite_update_freq = clip.update_freq;
+    m_sprite_current_frame_index = 0;
+    m_sprite_clip_index = index;
+
+    if (!registered) {
+        DrawingSequence::Instance().Register(this);
+    }
+    return true;
+}
+
 // 当用户想要将 pivot 应用于碰撞器时，调整本地 shape 以将枢轴偏移应用到形状（便于渲染/碰撞对齐）
 void BaseObject::TweakColliderWithPivot(const CF_V2& pivot) noexcept
 {
@@ -138,9 +205,12 @@ CF_Manifold BaseObject::ExclusionWithSolid(const ObjManager::ObjToken& oth, cons
     if (!oth.isValid() || !objs.IsValid(oth) || v2math::length(m.contact_points[0] - m.contact_points[1]) < 1e-3f) return m;
 
     BaseObject& other = objs[oth];
-    CF_V2 vel = GetVelocity();
     CF_Manifold result = m;
 
+    // 对方为 AABB 且自身未旋转时解析求解（沿速度的 slab 扫掠或沿法线推出）；仅旋转后的多边形等情况退回逐段回退与二分
+    if (ResolveSolidAnalytic(other, result)) return result;
+
+    CF_V2 vel = GetVelocity();
     float max_d = m.count == 2 ? std::max(m.depths[0], m.depths[1]) : m.depths[0];
     float dot = v2math::dot(vel, m.n);
     if (dot > 1e-3f && max_d - dot > 1e-3f) {
@@ -161,6 +231,58 @@ CF_Manifold BaseObject::ExclusionWithSolid(const ObjManager::ObjToken& oth, cons
     return result;
 }
 
+bool BaseObject::ResolveSolidAnalytic(const BaseObject& other, CF_Manifold& res) noexcept
+{
+    // 适用范围：对方为 AABB，自身为 AABB、未随对象旋转的多边形或连续碰撞体（已停在最早接触处）
+    const CF_ShapeType self_type = GetShape().type;
+    const bool unrotated = self_type == CF_SHAPE_TYPE_AABB
+        || (self_type == CF_SHAPE_TYPE_POLY && (!m_isColliderRotate || GetRotation() == 0.0f));
+    if (other.GetShape().type != CF_SHAPE_TYPE_AABB || !(unrotated || IsContinuousCollision())) return false;
+
+    // 以当前位置重新取得 manifold（同一帧之前的排斥可能已经移动过自身），法线由自身指向对方
+    if (!IsCollidedWith(other, res)) return true;
+    const float depth = res.count == 2 ? std::max(res.depths[0], res.depths[1]) : res.depths[0];
+
+    // 与逐段回退路径相同的判定：沿法线的自身位移不足以解释穿透深度（对方撞入或早已重叠）时沿法线推出；
+    // 否则重叠由自身本帧的运动造成，沿 -vel 回退到最早接触处，而不是沿最小穿透轴（落到平台边缘时那是水平方向）
+    const CF_V2 vel = GetVelocity();
+    const float dot = v2math::dot(vel, res.n);
+    if (unrotated && !(dot > 1e-3f && depth - dot > 1e-3f)) {
+        // 包围盒收缩 2 * EXCLUSION_SLOP 后扫掠：上一帧排斥留下的残余穿透不算作起点重叠（站在平台上持续下压的情形）
+        CF_Aabb self_box = PhysicsSystem::ShapeAabb(GetShape());
+        const CF_V2 margin = cf_v2(2.0f * EXCLUSION_SLOP, 2.0f * EXCLUSION_SLOP);
+        self_box.min = self_box.min + margin;
+        self_box.max = self_box.max - margin;
+        int axis = 0;
+        const float toi = PhysicsSystem::SweepAabbToi(self_box, vel, other.GetShape().u.aabb, &axis);
+        if (toi >= 0.0f) {
+            // 收缩盒刚好接触时真实穿透为 2 * EXCLUSION_SLOP，再沿接触轴退出一半，保留 EXCLUSION_SLOP 的残余穿透；
+            // 剩余位移去掉接触轴分量后继续，与逐段前进时沿表面滑动一致
+            CF_V2 back = vel * (1.0f - toi);
+            CF_V2 slide = back;
+            if (axis == 0) {
+                back.x += std::copysign(EXCLUSION_SLOP, vel.x);
+                slide.x = 0.0f;
+            }
+            else {
+                back.y += std::copysign(EXCLUSION_SLOP, vel.y);
+                slide.y = 0.0f;
+            }
+            SetPosition(GetPosition() - back + slide);
+            IsCollidedWith(other, res);
+            return true;
+        }
+        // 起点已重叠（或速度为零）：没有可回退的接触时刻，按法线推出
+    }
+
+    // 保留 EXCLUSION_SLOP 的残余穿透，与二分逼近一样停在“刚好接触”的一侧，保证后续仍能检测到该接触
+    if (depth > EXCLUSION_SLOP) {
+        SetPosition(GetPosition() - res.n * (depth - EXCLUSION_SLOP));
+        IsCollidedWith(other, res);
+    }
+    return true;
+}
+
 void BaseObject::FindContactPos(CF_V2 current, CF_V2 offset, const BaseObject& other, CF_Manifold& res) {
     CF_V2 cur = current;
     CF_V2 side = cur - offset;
@@ -208,6 +330,9 @@ BaseObject::~BaseObject() noexcept
     OnDestroy();
     DrawingSequence::Instance().Unregister(this);
     if (!m_sprite_path.empty()) {
-        cf_easy_sprite_unload(&m_sprite);
+        SpriteCache::Instance().Release(m_sprite_path);
+    }
+    for (const SpriteClip& clip : m_sprite_clips) {
+        SpriteCache::Instance().Release(clip.path);
     }
 }
\ No newline at end of file
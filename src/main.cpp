@@ -1,15 +1,19 @@
 #include <chrono>
+#include <cmath>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
 #include <atomic>
 #include <string>
 #include <iomanip>
+#include <thread>
+#include <algorithm>
 
 #include "debug_config.h"
 #include "delegate.h"
 #include "base_object.h"
 #include "drawing_sequence.h"
+#include "sprite_cache.h"
 #include "obj_manager.h"
 #include "UI_draw.h"
 #include "room_loader.h"
@@ -20,7 +24,7 @@
 std::atomic<int> g_frame_count{0};
 // 多播委托：无参数、无返回值
 Delegate<> main_thread_on_update;
-// 全局帧率（每秒帧数）
+// 全局逻辑帧率（每秒固定逻辑步数；g_frame_count 按逻辑步递增）
 int g_frame_rate = 50;
 
 extern Delegate<> main_thread_on_update;
@@ -31,6 +35,9 @@ namespace {
 		OUTPUT({ "Memory" }, phase,
 			"DrawingSequence bytes=", DrawingSequence::Instance().GetEstimatedMemoryUsageBytes(),
 			"ObjManager bytes=", ObjManager::Instance().GetEstimatedMemoryUsageBytes(),
+			"SpriteCache bytes=", SpriteCache::Instance().GetEstimatedMemoryUsageBytes(),
+			"SpriteCache entries=", SpriteCache::Instance().Count(),
+			"PhysicsSystem bytes=", PhysicsSystem::Instance().GetEstimatedMemoryUsageBytes(),
 			"RoomLoader bytes=", RoomLoader::Instance().GetEstimatedMemoryUsageBytes());
 	}
 }
@@ -55,6 +62,19 @@ int main(int argc, char* argv[])
 	// 记录窗口半宽高，用于 UI 绘制
 	DrawUI::half_w = static_cast<float>(window_width) * 0.5f;
 	DrawUI::half_h = static_cast<float>(window_height) * 0.5f;
+
+	// 物理激活区域：镜头固定在原点，取屏幕范围外扩 kActivationMargin；离屏过远的对象暂停模拟
+	// （若以后加入滚动镜头，应在每个逻辑步前按镜头位置更新该区域）
+	constexpr float kActivationMargin = 256.0f;
+	PhysicsSystem::Instance().SetActivationRegion(CF_Aabb{
+		cf_v2(-DrawUI::half_w - kActivationMargin, -DrawUI::half_h - kActivationMargin),
+		cf_v2(DrawUI::half_w + kActivationMargin, DrawUI::half_h + kActivationMargin) });
+	// narrowphase 工作线程：主线程之外最多使用 kMaxPhysicsWorkers 个核心（单核或无法探测时为 0，即串行）
+	// 事件与回调顺序与串行一致，线程数只影响候选对较多的帧的耗时
+	constexpr unsigned kMaxPhysicsWorkers = 3;
+	const unsigned hw_threads = std::thread::hardware_concurrency();
+	PhysicsSystem::Instance().SetWorkerThreads(hw_threads > 1 ? std::min(hw_threads - 1, kMaxPhysicsWorkers) : 0);
+	OUTPUT({"Main"}, "Physics worker threads =", PhysicsSystem::Instance().GetWorkerThreads());
 	{
 		// 挂载 content 目录到虚拟根 "/"，使资源可用为 "/sprites/idle.png"
 		CF_Path base = fs_get_base_directory();
@@ -64,8 +84,14 @@ int main(int argc, char* argv[])
 		fs_mount(base.c_str(), "");
 	}
 
-	// 设置目标帧率
-	cf_set_target_framerate(g_frame_rate);
+	// 渲染不再锁定到逻辑帧率：随显示器刷新率（垂直同步）绘制，逻辑按固定步长推进
+	cf_app_set_vsync(true);
+	// 固定步长累加器：每个渲染帧累加真实经过时间，按 step_seconds 消耗为 0~N 个逻辑步
+	const double step_seconds = 1.0 / static_cast<double>(g_frame_rate);
+	// 单个渲染帧内最多执行的逻辑步数，防止卡顿后追帧导致“死亡螺旋”
+	constexpr int kMaxStepsPerFrame = 5;
+	double accumulator = 0.0;
+	auto last_frame_time = std::chrono::steady_clock::now();
 
 	// 尝试恢复存档
 	auto& player_state = GlobalPlayer::Instance();
@@ -91,20 +117,51 @@ int main(int argc, char* argv[])
 	{
 		// 一次性日志：主循环成功启动，app_update 可用
 		static bool _once = false;
-		if (!_once) { OUTPUT({"LOOP"}, "app_update OK, current frame rate:", g_frame_rate); _once = true; }
+		if (!_once) { OUTPUT({"LOOP"}, "app_update OK, fixed step rate:", g_frame_rate); _once = true; }
 
 		//--------------------更新阶段--------------------
-		// 全局帧计数递增
-		g_frame_count++;
-		// 调用 Cute Framework 更新
+		// 调用 Cute Framework 更新（输入/窗口事件每个渲染帧采集一次）
 		app_update();
-		// 调用主线程更新委托
-		main_thread_on_update(); 
-		// 更新所有对象（物理积分/碰撞检测/行为更新等）
-		objs.UpdateAll();
-		// 更新当前房间
-		RoomLoader::Instance().UpdateCurrent();
-		
+		// 锁存本帧输入 edge，交由接下来的第一个逻辑步消费
+		Input::LatchFrameEdges();
+
+		auto frame_now = std::chrono::steady_clock::now();
+		accumulator += std::chrono::duration<double>(frame_now - last_frame_time).count();
+		last_frame_time = frame_now;
+
+		int steps = 0;
+		while (accumulator >= step_seconds && steps < kMaxStepsPerFrame)
+		{
+			accumulator -= step_seconds;
+			++steps;
+			// 全局帧计数按逻辑步递增
+			g_frame_count++;
+			// 记录上一步结束时的位置（渲染插值起点），须在脚本移动对象之前
+			objs.BeginStep();
+			// 调用主线程更新委托
+			main_thread_on_update();
+			// 更新所有对象（物理积分/碰撞检测/行为更新等）
+			objs.UpdateAll();
+			// 更新当前房间
+			RoomLoader::Instance().UpdateCurrent();
+
+			// 按 R 键重生
+			if (Input::IsKeyInState(CF_KEY_R, KeyState::Down)) {
+				OUTPUT({ "Main" }, "R Pressed, start respawn process");
+				LogContainerMemorySnapshot("BeforeRespawn");
+				RoomLoader::Instance().Load(*GlobalPlayer::Instance().GetRespawnRoom());
+				LogContainerMemorySnapshot("AfterRespawn");
+			}
+			// edge 已被本逻辑步消费
+			Input::ClearLatchedEdges();
+		}
+		// 达到单帧步数上限时丢弃积压时间，只保留不足一步的余量
+		if (steps == kMaxStepsPerFrame && accumulator >= step_seconds) {
+			accumulator = std::fmod(accumulator, step_seconds);
+		}
+		// 渲染插值系数：余量占一个逻辑步的比例
+		DrawingSequence::Instance().SetInterpolationAlpha(static_cast<float>(accumulator / step_seconds));
+
 		// 处理 ESC 键：计时退出
 		if (cf_key_down(CF_KEY_ESCAPE))
 		{
@@ -131,14 +188,6 @@ int main(int argc, char* argv[])
 		auto& player = GlobalPlayer::Instance().Player();
 		game_over = !objs.TryGetRegisteration(player);
 
-		// 按 R 键重生
-		if (Input::IsKeyInState(CF_KEY_R, KeyState::Down)) {
-			OUTPUT({ "Main" }, "R Pressed, start respawn process");
-			LogContainerMemorySnapshot("BeforeRespawn");
-			RoomLoader::Instance().Load(*GlobalPlayer::Instance().GetRespawnRoom());
-			LogContainerMemorySnapshot("AfterRespawn");
-		}
-
 		//--------------------绘制阶段--------------------
 		try {
 			DrawingSequence::Instance().DrawAll();
@@ -161,6 +210,8 @@ int main(int argc, char* argv[])
 	// 程序退出：
 	// 由控制器销毁所有对象
 	objs.DestroyAll();
+	// 所有对象已归还引用，统一卸载缓存的精灵纹理
+	SpriteCache::Instance().Clear();
 	// 清理主线程更新委托
 	main_thread_on_update.clear();
 	// 销毁应用程序
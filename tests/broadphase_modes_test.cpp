@@ -0,0 +1,80 @@
+// broadphase 后端（user-005 / user-006）：GRID、SWEEP_AND_PRUNE 与 AABB_TREE 在同一场景上必须产生完全相同的
+// 碰撞事件序列与空间查询结果；运行中切换后端也不得改变结果
+#include "test_common.h"
+
+#include <algorithm>
+
+using namespace test;
+
+namespace {
+
+constexpr int kStatics = 300;
+constexpr int kMovers = 200;
+constexpr int kFrames = 40;
+
+struct Run {
+	std::vector<ContactEvent> events;
+	std::vector<std::vector<int>> queries; // 每 5 帧一次 QueryAabb 命中的 Probe id（升序）
+};
+
+std::vector<int> query_ids(const CF_Aabb& box)
+{
+	std::vector<ObjManager::ObjToken> tokens;
+	PhysicsSystem::Instance().QueryAabb(box, tokens);
+	std::vector<int> ids;
+	ObjManager& objs = ObjManager::Instance();
+	for (const ObjManager::ObjToken& t : tokens) {
+		if (const Probe* p = dynamic_cast<const Probe*>(&objs[t])) ids.push_back(p->Id());
+	}
+	std::sort(ids.begin(), ids.end());
+	return ids;
+}
+
+// schedule 为空时全程使用 mode；否则第 i 个 5 帧区间使用 schedule[i % size]
+Run run_scene(BroadphaseMode mode, const std::vector<BroadphaseMode>& schedule = {})
+{
+	ResetWorld();
+	PhysicsSystem::Instance().SetBroadphaseMode(mode);
+	SpawnRandomScene(20261016u, kStatics, kMovers);
+	Run r;
+	const CF_Aabb box{ cf_v2(100.0f, 100.0f), cf_v2(400.0f, 300.0f) };
+	for (int chunk = 0; chunk < kFrames / 5; ++chunk) {
+		if (!schedule.empty()) PhysicsSystem::Instance().SetBroadphaseMode(schedule[chunk % schedule.size()]);
+		RunFrames(5);
+		r.queries.push_back(query_ids(box));
+	}
+	r.events = g_events;
+	return r;
+}
+
+void report_first_difference(const char* label, const std::vector<ContactEvent>& want, const std::vector<ContactEvent>& got)
+{
+	const size_t n = std::min(want.size(), got.size());
+	size_t i = 0;
+	while (i < n && want[i] == got[i]) ++i;
+	std::printf("%s: %zu vs %zu events, first difference at %zu\n", label, want.size(), got.size(), i);
+}
+
+void compare(const char* label, const Run& want, const Run& got)
+{
+	if (want.events != got.events) report_first_difference(label, want.events, got.events);
+	MCG_CHECK(want.events == got.events);
+	MCG_CHECK(want.queries == got.queries);
+}
+
+} // namespace
+
+int main()
+{
+	const Run grid = run_scene(BroadphaseMode::GRID);
+	// 场景必须真的产生接触（含 Exit）与查询命中，否则比较没有意义
+	MCG_CHECK(grid.events.size() > 500);
+	MCG_CHECK(std::any_of(grid.events.begin(), grid.events.end(), [](const ContactEvent& e) { return e.phase == 'X'; }));
+	MCG_CHECK(!grid.queries.front().empty());
+
+	compare("SWEEP_AND_PRUNE", grid, run_scene(BroadphaseMode::SWEEP_AND_PRUNE));
+	compare("AABB_TREE", grid, run_scene(BroadphaseMode::AABB_TREE));
+	compare("switching", grid, run_scene(BroadphaseMode::GRID,
+		{ BroadphaseMode::AABB_TREE, BroadphaseMode::SWEEP_AND_PRUNE, BroadphaseMode::GRID }));
+	return Finish("broadphase_modes_test");
+}
@@ -0,0 +1,109 @@
+// 碰撞阶段（user-010 / user-019）：跨帧的 Enter / Stay / Exit 序列，以及接触中销毁对象时对方收到的 Exit
+#include "test_common.h"
+
+using namespace test;
+
+namespace {
+
+std::vector<ContactEvent> expect(std::initializer_list<ContactEvent> list) { return std::vector<ContactEvent>(list); }
+
+// 动态体以 10 px/帧从右向左穿过静态方块：第 1 帧提交，之后每帧先移动再 Step
+// 位置（中心 x）：f2=40 f3=30 f4=20 f5=10 f6=0 f7=-10 f8=-20；双方半宽 10 / 5，f5~f7 重叠
+void pass_through_static()
+{
+	ResetWorld();
+	Spawn({ .id = 1, .pos = { 0.0f, 0.0f }, .half = { 10.0f, 10.0f }, .kind = BodyKind::STATIC });
+	Spawn({ .id = 2, .pos = { 50.0f, 0.0f }, .half = { 5.0f, 5.0f }, .vel = { -10.0f, 0.0f } });
+	RunFrames(10);
+
+	const auto mover = EventsOf(2);
+	const auto block = EventsOf(1);
+	const auto want_mover = expect({ { 5, 'E', 2, 1 }, { 6, 'S', 2, 1 }, { 7, 'S', 2, 1 }, { 8, 'X', 2, 1 } });
+	const auto want_block = expect({ { 5, 'E', 1, 2 }, { 6, 'S', 1, 2 }, { 7, 'S', 1, 2 }, { 8, 'X', 1, 2 } });
+	if (mover != want_mover) PrintEvents("pass_through_static mover", mover);
+	if (block != want_block) PrintEvents("pass_through_static block", block);
+	MCG_CHECK(mover == want_mover);
+	MCG_CHECK(block == want_block);
+}
+
+// 两个动态体相向运动后分开：双方收到对称的序列
+void dynamic_pair()
+{
+	ResetWorld();
+	Spawn({ .id = 1, .pos = { -30.0f, 0.0f }, .half = { 5.0f, 5.0f }, .vel = { 5.0f, 0.0f } });
+	Spawn({ .id = 2, .pos = { 30.0f, 0.0f }, .half = { 5.0f, 5.0f }, .vel = { -5.0f, 0.0f } });
+	RunFrames(12);
+
+	std::vector<ContactEvent> a = EventsOf(1), b = EventsOf(2);
+	MCG_CHECK(!a.empty());
+	MCG_CHECK_EQ(a.size(), b.size());
+	for (size_t i = 0; i < a.size() && i < b.size(); ++i) {
+		MCG_CHECK_EQ(a[i].frame, b[i].frame);
+		MCG_CHECK_EQ(a[i].phase, b[i].phase);
+	}
+	// 每段接触都以一次 Enter 开始、一次 Exit 结束，中间只有 Stay
+	if (!a.empty()) {
+		MCG_CHECK_EQ(a.front().phase, 'E');
+		MCG_CHECK_EQ(a.back().phase, 'X');
+		for (size_t i = 1; i + 1 < a.size(); ++i) MCG_CHECK_EQ(a[i].phase, 'S');
+	}
+}
+
+// 接触中销毁动态体：静态方块在销毁发生的那一帧收到一次 Exit（对方 token 仍有效），之后不再有事件
+void destroy_during_contact()
+{
+	ResetWorld();
+	Spawn({ .id = 1, .pos = { 0.0f, 0.0f }, .half = { 10.0f, 10.0f }, .kind = BodyKind::STATIC });
+	ObjManager::ObjToken mover = Spawn({ .id = 2, .pos = { 5.0f, 0.0f }, .half = { 5.0f, 5.0f } });
+	RunFrames(3); // f1 提交，f2 Enter，f3 Stay
+	ObjManager::Instance().TryGetRegisteration(mover);
+	ObjManager::Instance().Destroy(mover);
+	RunFrames(3); // f4 的销毁阶段执行 Unregister
+
+	const auto block = EventsOf(1);
+	const auto want = expect({ { 2, 'E', 1, 2 }, { 3, 'S', 1, 2 }, { 4, 'S', 1, 2 }, { 4, 'X', 1, 2 } });
+	if (block != want) PrintEvents("destroy_during_contact block", block);
+	MCG_CHECK(block == want);
+	MCG_CHECK_EQ(EventsOf(2).size(), 3u); // 被销毁的一方不会收到自己的 Exit
+}
+
+// 接触中销毁静态方块：停在其中的动态体收到 Exit
+void destroy_static_during_contact()
+{
+	ResetWorld();
+	ObjManager::ObjToken block = Spawn({ .id = 1, .pos = { 0.0f, 0.0f }, .half = { 10.0f, 10.0f }, .kind = BodyKind::STATIC });
+	Spawn({ .id = 2, .pos = { 5.0f, 0.0f }, .half = { 5.0f, 5.0f } });
+	RunFrames(2);
+	ObjManager::Instance().TryGetRegisteration(block);
+	ObjManager::Instance().Destroy(block);
+	RunFrames(3);
+
+	const auto mover = EventsOf(2);
+	const auto want = expect({ { 2, 'E', 2, 1 }, { 3, 'S', 2, 1 }, { 3, 'X', 2, 1 } });
+	if (mover != want) PrintEvents("destroy_static_during_contact mover", mover);
+	MCG_CHECK(mover == want);
+}
+
+// DestroyAll（房间卸载）不派发 Exit
+void destroy_all_is_silent()
+{
+	ResetWorld();
+	Spawn({ .id = 1, .pos = { 0.0f, 0.0f }, .half = { 10.0f, 10.0f }, .kind = BodyKind::STATIC });
+	Spawn({ .id = 2, .pos = { 5.0f, 0.0f }, .half = { 5.0f, 5.0f } });
+	RunFrames(3);
+	const size_t before = g_events.size();
+	ObjManager::Instance().DestroyAll();
+	MCG_CHECK_EQ(g_events.size(), before);
+}
+
+} // namespace
+
+int main()
+{
+	pass_through_static();
+	dynamic_pair();
+	destroy_during_contact();
+	destroy_static_during_contact();
+	destroy_all_is_silent();
+	return Finish("contact_events_test");
+}
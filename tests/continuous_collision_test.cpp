@@ -0,0 +1,102 @@
+// 连续碰撞（user-016）：高速小子弹（8x4 AABB，每帧 60 px）不得穿过 36 px 的瓦片；
+// 对照组关闭连续碰撞，确认同一场景在离散检测下确实会穿透。瓦片为 SOLID（连续碰撞只对 SOLID 目标扫掠）。
+// 默认开启 IsColliderApplyPivot 时 world shape 中的 AABB 以四边形缓存，扫掠走 cf_toi；
+// 同时关闭旋转与 pivot 后 world shape 保持 AABB，扫掠走 sweep_aabb_toi，两条路径都要覆盖
+#include "test_common.h"
+
+using namespace test;
+
+namespace {
+
+constexpr float kTileHalf = 18.0f; // 36 px 瓦片
+constexpr float kSpeed = 60.0f;
+
+// 命中后停下的子弹（游戏中的子弹命中即销毁，这里停下以便检查最终位置）
+class StopOnHit : public Probe {
+public:
+	using Probe::Probe;
+	void OnCollisionEnter(const ObjManager::ObjToken& other, const CF_Manifold& manifold) noexcept override
+	{
+		Probe::OnCollisionEnter(other, manifold);
+		SetVelocity(cf_v2(0.0f, 0.0f));
+	}
+};
+
+// 关闭旋转与 pivot，使 world shape 保持 AABB
+void keep_aabb(ObjManager::ObjToken token)
+{
+	BaseObject& obj = ObjManager::Instance()[token];
+	obj.IsColliderRotate(false);
+	obj.IsColliderApplyPivot(false);
+}
+
+// 瓦片中心 (100, 0)，子弹从 x = 10 出发：f2 位于 70（尚未接触），f3 离散位置为 130，已完全越过瓦片 [82, 118]
+ObjManager::ObjToken spawn_horizontal(bool continuous, bool aabb = false)
+{
+	ResetWorld();
+	ObjManager::ObjToken tile = Spawn({ .id = 1, .pos = { 100.0f, 0.0f }, .half = { kTileHalf, kTileHalf },
+		.kind = BodyKind::STATIC, .collider = ColliderType::SOLID });
+	ObjManager::ObjToken bullet = ObjManager::Instance().Create<StopOnHit>(ProbeDesc{ .id = 2, .pos = { 10.0f, 0.0f },
+		.half = { 4.0f, 2.0f }, .vel = { kSpeed, 0.0f }, .continuous = continuous, .category = CollisionLayer::PROJECTILE });
+	if (aabb) {
+		keep_aabb(tile);
+		keep_aabb(bullet);
+	}
+	return bullet;
+}
+
+float x_of(ObjManager::ObjToken token) { return ObjManager::Instance()[token].GetPosition().x; }
+
+void discrete_tunnels()
+{
+	ObjManager::ObjToken bullet = spawn_horizontal(false);
+	RunFrames(5);
+	MCG_CHECK(g_events.empty());
+	MCG_CHECK(x_of(bullet) > 100.0f + kTileHalf);
+}
+
+void continuous_stops_at_tile(bool aabb)
+{
+	ObjManager::ObjToken bullet = spawn_horizontal(true, aabb);
+	RunFrames(3);
+	const auto hits = EventsOf(2);
+	MCG_CHECK(!hits.empty());
+	if (!hits.empty()) {
+		MCG_CHECK_EQ(hits.front().frame, 3);
+		MCG_CHECK_EQ(hits.front().phase, 'E');
+		MCG_CHECK_EQ(hits.front().other, 1);
+	}
+	// 停在瓦片左边缘：子弹右边缘 (x + 4) 只嵌入 CONTINUOUS_SKIN 量级
+	const float right = x_of(bullet) + 4.0f;
+	MCG_CHECK(right >= 100.0f - kTileHalf - 0.001f);
+	MCG_CHECK(right <= 100.0f - kTileHalf + 0.1f);
+	MCG_CHECK(EventsOf(1).size() == hits.size()); // 瓦片一侧同样收到 Enter
+
+	RunFrames(3);
+	MCG_CHECK(x_of(bullet) + 4.0f <= 100.0f - kTileHalf + 0.1f);
+}
+
+// 竖直下落穿过地面瓦片，速度同样超过瓦片厚度
+void continuous_falling_onto_floor()
+{
+	ResetWorld();
+	Spawn({ .id = 1, .pos = { 0.0f, 0.0f }, .half = { kTileHalf, kTileHalf }, .kind = BodyKind::STATIC, .collider = ColliderType::SOLID });
+	ObjManager::ObjToken bullet = ObjManager::Instance().Create<StopOnHit>(ProbeDesc{ .id = 2, .pos = { 3.0f, 100.0f },
+		.half = { 2.0f, 4.0f }, .vel = { 0.0f, -kSpeed }, .continuous = true });
+	RunFrames(6);
+	const auto hits = EventsOf(2);
+	MCG_CHECK(!hits.empty() && hits.front().phase == 'E' && hits.front().other == 1);
+	const float bottom = ObjManager::Instance()[bullet].GetPosition().y - 4.0f;
+	MCG_CHECK(bottom >= kTileHalf - 0.1f);
+}
+
+} // namespace
+
+int main()
+{
+	discrete_tunnels();
+	continuous_stops_at_tile(false);
+	continuous_stops_at_tile(true);
+	continuous_falling_onto_floor();
+	return Finish("continuous_collision_test");
+}
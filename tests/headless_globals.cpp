@@ -0,0 +1,11 @@
+// 无窗口构建（测试 / 基准）使用的全局变量：与 src/main.cpp 中的定义一一对应，
+// 供 ObjManager、ActSeq 与各对象在不链接 main.cpp 时使用。
+#include <atomic>
+#include "delegate.h"
+
+// 全局帧计数（按逻辑步递增）
+std::atomic<int> g_frame_count{0};
+// 多播委托：无参数、无返回值
+Delegate<> main_thread_on_update;
+// 全局逻辑帧率
+int g_frame_rate = 50;
@@ -0,0 +1,111 @@
+// pending token（user-024）：Create 返回的 token 在提交前后、提交前被销毁以及槽位被复用时的解析结果
+#include "test_common.h"
+
+#include <utility>
+
+using namespace test;
+
+namespace {
+
+int probe_id(ObjManager::ObjToken& token)
+{
+	const Probe* p = dynamic_cast<const Probe*>(&ObjManager::Instance()[token]);
+	return p ? p->Id() : -1;
+}
+
+// 提交前：token 未注册、不能解析，但可以经 operator[] 访问 pending 对象；提交后解析为同一 (index, generation)
+void resolves_after_commit()
+{
+	ResetWorld();
+	ObjManager& objs = ObjManager::Instance();
+	ObjManager::ObjToken pending = Spawn({ .id = 7 });
+	MCG_CHECK(pending.isValid());
+	MCG_CHECK(!pending.isRegitsered);
+	MCG_CHECK(!objs.TryGetRegisteration(std::as_const(pending)));
+	MCG_CHECK(!objs.IsValid(pending));
+	MCG_CHECK_EQ(objs.Count(), 1u);
+	ObjManager::ObjToken peek = pending;
+	MCG_CHECK_EQ(probe_id(peek), 7);
+	MCG_CHECK(!peek.isRegitsered);
+
+	RunFrames(1);
+	MCG_CHECK(objs.TryGetRegisteration(std::as_const(pending)));
+	ObjManager::ObjToken resolved = pending;
+	MCG_CHECK(objs.TryGetRegisteration(resolved));
+	MCG_CHECK(resolved.isRegitsered);
+	MCG_CHECK(resolved == pending);
+	MCG_CHECK(objs.IsValid(resolved));
+	MCG_CHECK_EQ(probe_id(resolved), 7);
+	const Probe& probe = dynamic_cast<const Probe&>(objs[resolved]);
+	MCG_CHECK(probe.Token() == resolved);
+	MCG_CHECK(probe.Token().isRegitsered);
+}
+
+// 提交前销毁：对象立即析构，token 永远不能解析，也不会参与物理
+void destroy_before_commit()
+{
+	ResetWorld();
+	ObjManager& objs = ObjManager::Instance();
+	Spawn({ .id = 1, .pos = { 0.0f, 0.0f }, .half = { 10.0f, 10.0f }, .kind = BodyKind::STATIC });
+	ObjManager::ObjToken doomed = Spawn({ .id = 2, .pos = { 5.0f, 0.0f } });
+	objs.Destroy(doomed);
+	MCG_CHECK_EQ(objs.Count(), 1u);
+	objs.Destroy(doomed); // 重复销毁为 no-op
+	MCG_CHECK_EQ(objs.Count(), 1u);
+
+	RunFrames(3);
+	MCG_CHECK(!objs.TryGetRegisteration(std::as_const(doomed)));
+	ObjManager::ObjToken copy = doomed;
+	MCG_CHECK(!objs.TryGetRegisteration(copy));
+	MCG_CHECK(!objs.IsValid(doomed));
+	MCG_CHECK_EQ(objs.Count(), 1u);
+	MCG_CHECK(EventsOf(1).empty());
+	MCG_CHECK(EventsOf(2).empty());
+}
+
+// 提交前销毁后槽位被新对象复用：旧 token 因 generation 不同仍然无效，不会解析到新对象
+void reused_slot_keeps_old_token_dead()
+{
+	ResetWorld();
+	ObjManager& objs = ObjManager::Instance();
+	ObjManager::ObjToken old_token = Spawn({ .id = 1 });
+	objs.Destroy(old_token);
+	ObjManager::ObjToken new_token = Spawn({ .id = 2 });
+	MCG_CHECK_EQ(new_token.index, old_token.index);
+	MCG_CHECK(new_token.generation != old_token.generation);
+	MCG_CHECK(new_token != old_token);
+
+	RunFrames(1);
+	MCG_CHECK(!objs.TryGetRegisteration(std::as_const(old_token)));
+	MCG_CHECK(objs.TryGetRegisteration(std::as_const(new_token)));
+	MCG_CHECK_EQ(probe_id(new_token), 2);
+}
+
+// 提交后用保存的 pending token 销毁：转为延迟销毁，下一帧生效，接触中的对方收到 Exit
+void destroy_with_pending_token_after_commit()
+{
+	ResetWorld();
+	ObjManager& objs = ObjManager::Instance();
+	Spawn({ .id = 1, .pos = { 0.0f, 0.0f }, .half = { 10.0f, 10.0f }, .kind = BodyKind::STATIC });
+	const ObjManager::ObjToken pending = Spawn({ .id = 2, .pos = { 5.0f, 0.0f } });
+	RunFrames(2); // f2 Enter
+	objs.Destroy(pending);
+	MCG_CHECK(objs.IsValid(pending)); // 仍在队列中，UpdateAll 的销毁阶段才执行
+	RunFrames(1);
+	MCG_CHECK(!objs.IsValid(pending));
+	MCG_CHECK(!objs.TryGetRegisteration(std::as_const(pending)));
+	MCG_CHECK_EQ(objs.Count(), 1u);
+	const auto block = EventsOf(1);
+	MCG_CHECK(!block.empty() && block.back().phase == 'X' && block.back().frame == 3);
+}
+
+} // namespace
+
+int main()
+{
+	resolves_after_commit();
+	destroy_before_commit();
+	reused_slot_keeps_old_token_dead();
+	destroy_with_pending_token_after_commit();
+	return Finish("pending_tokens_test");
+}
@@ -0,0 +1,86 @@
+// 渲染插值（user-018）：GetRenderPosition(alpha) 在上一逻辑步结束位置与当前位置之间插值。
+// ActSeq 在 main_thread_on_update 中移动对象（早于 UpdateAll），起点必须在此之前记录，否则脚本驱动的对象不会被插值，
+// 与按速度移动、站在其上的对象相互抖动
+#include "test_common.h"
+
+#include "act_seq.h"
+
+#include <cmath>
+
+using namespace test;
+
+namespace {
+
+constexpr float kStep = 3.0f;   // 每逻辑步位移（像素）
+constexpr int kScriptFrames = 10;
+
+// 由 ActSeq 逐帧 SetPosition 推动的对象，对应 LeftMoveBlock / MoveSpike 等
+class ScriptedMover : public Probe {
+public:
+	using Probe::Probe;
+	void Start() override
+	{
+		Probe::Start();
+		m_act_seq.add(kScriptFrames, [](BaseObject* obj, int, int) {
+			obj->SetPosition(obj->GetPosition() + cf_v2(kStep, 0.0f));
+		});
+		m_act_seq.play(this);
+	}
+
+private:
+	ActSeq m_act_seq;
+};
+
+bool near(float a, float b) { return std::fabs(a - b) < 1e-4f; }
+
+void scripted_and_velocity_movers_interpolate_together()
+{
+	ResetWorld();
+	ObjManager& objs = ObjManager::Instance();
+	ObjManager::ObjToken block = objs.Create<ScriptedMover>(ProbeDesc{ .id = 1, .pos = { 0.0f, 0.0f }, .kind = BodyKind::KINEMATIC });
+	// 与方块同速、位于其上方的“乘客”，按速度移动
+	ObjManager::ObjToken rider = Spawn({ .id = 2, .pos = { 0.0f, 20.0f }, .vel = { kStep, 0.0f } });
+	RunFrames(1); // 提交
+
+	for (int f = 0; f < kScriptFrames - 2; ++f) {
+		const float block_before = objs[block].GetPosition().x;
+		const float rider_before = objs[rider].GetPosition().x;
+		RunFrames(1);
+		const BaseObject& b = objs[block];
+		const BaseObject& r = objs[rider];
+		MCG_CHECK(near(b.GetPosition().x, block_before + kStep));
+		MCG_CHECK(near(r.GetPosition().x, rider_before + kStep));
+		for (float alpha : { 0.0f, 0.25f, 0.5f, 1.0f }) {
+			const CF_V2 bp = b.GetRenderPosition(alpha);
+			const CF_V2 rp = r.GetRenderPosition(alpha);
+			// 渲染位置位于两次逻辑步位置之间
+			MCG_CHECK(near(bp.x, block_before + kStep * alpha));
+			MCG_CHECK(near(rp.x, rider_before + kStep * alpha));
+			// 乘客与方块的相对位置在任意 alpha 下保持不变
+			MCG_CHECK(near(rp.x - bp.x, r.GetPosition().x - b.GetPosition().x));
+		}
+	}
+	RunFrames(4); // 让动作链播放完毕并从 main_thread_on_update 移除，之后才能销毁对象
+}
+
+// 尚未经历逻辑步的对象与单步大位移（传送）直接返回当前位置
+void snaps_without_history_or_on_teleport()
+{
+	ResetWorld();
+	ObjManager& objs = ObjManager::Instance();
+	ObjManager::ObjToken t = Spawn({ .id = 1, .pos = { 500.0f, 0.0f } });
+	MCG_CHECK(near(objs[t].GetRenderPosition(0.0f).x, 500.0f));
+	RunFrames(2);
+	MCG_CHECK(near(objs[t].GetRenderPosition(0.5f).x, 500.0f));
+	objs[t].SetPosition(cf_v2(1000.0f, 0.0f)); // 重生/传送
+	MCG_CHECK(near(objs[t].GetRenderPosition(0.5f).x, 1000.0f));
+}
+
+} // namespace
+
+int main()
+{
+	scripted_and_velocity_movers_interpolate_together();
+	snaps_without_history_or_on_teleport();
+	return Finish("render_interpolation_test");
+}
@@ -0,0 +1,102 @@
+// 固体排斥（user-017）：ExcludeWithSolids 的对象下落到平台边缘、水平悬出量小于竖直穿透深度时，
+// 最小穿透轴是水平方向；重叠由自身运动造成，必须沿 -vel 回退落在平台上，而不是被横向推离平台。
+// 默认碰撞体标志下 world shape 为四边形，走逐段回退与二分；关闭旋转与 pivot 后保持 AABB，走解析路径
+#include "test_common.h"
+
+#include <cmath>
+
+using namespace test;
+
+namespace {
+
+constexpr float kLedgeHalf = 18.0f; // 平台 [-18, 18] x [-18, 18]，顶面 y = 18，右边缘 x = 18
+constexpr float kHalf = 8.0f;       // 下落者 16x16
+constexpr float kFall = 7.5f;       // 每帧下落速度
+constexpr float kTolerance = 0.1f; // 逐段回退路径的二分精度
+
+void keep_aabb(ObjManager::ObjToken token)
+{
+	BaseObject& obj = ObjManager::Instance()[token];
+	obj.IsColliderRotate(false);
+	obj.IsColliderApplyPivot(false);
+}
+
+struct Landing {
+	ObjManager::ObjToken faller;
+	float start_x = 0.0f;
+};
+
+// 下落者中心 x = 18 + 8 - overhang，与平台水平重叠 overhang；起始底边高出顶面 3 px，下一步穿透 4.5 px
+Landing spawn_ledge(float overhang, float vel_x, bool aabb)
+{
+	ResetWorld();
+	ObjManager& objs = ObjManager::Instance();
+	ObjManager::ObjToken ledge = Spawn({ .id = 1, .pos = { 0.0f, 0.0f }, .half = { kLedgeHalf, kLedgeHalf },
+		.kind = BodyKind::STATIC, .collider = ColliderType::SOLID });
+	const float x = kLedgeHalf + kHalf - overhang;
+	ObjManager::ObjToken faller = Spawn({ .id = 2, .pos = { x, kLedgeHalf + kHalf + 3.0f + kFall }, .half = { kHalf, kHalf },
+		.vel = { vel_x, -kFall } });
+	objs[faller].ExcludeWithSolids(true);
+	if (aabb) {
+		keep_aabb(ledge);
+		keep_aabb(faller);
+	}
+	return Landing{ faller, x };
+}
+
+float bottom_of(ObjManager::ObjToken t) { return ObjManager::Instance()[t].GetPosition().y - kHalf; }
+float x_of(ObjManager::ObjToken t) { return ObjManager::Instance()[t].GetPosition().x; }
+
+// 竖直下落、悬出 2 px（小于 4.5 px 穿透）：落在平台上，x 不变
+void lands_on_ledge(bool aabb)
+{
+	const Landing l = spawn_ledge(2.0f, 0.0f, aabb);
+	RunFrames(3); // f1 提交，f2 下落到顶面上方 3 px，f3 穿透并排斥
+	MCG_CHECK(!EventsOf(2).empty());
+	MCG_CHECK(std::fabs(bottom_of(l.faller) - kLedgeHalf) < kTolerance);
+	MCG_CHECK(std::fabs(x_of(l.faller) - l.start_x) < kTolerance);
+
+	RunFrames(5); // 持续下压，仍停在平台上
+	MCG_CHECK(std::fabs(bottom_of(l.faller) - kLedgeHalf) < kTolerance);
+	MCG_CHECK(std::fabs(x_of(l.faller) - l.start_x) < kTolerance);
+}
+
+// 带水平速度向平台外侧移动时落地：停在顶面，水平位移保留
+void lands_while_moving_outward(bool aabb)
+{
+	const Landing l = spawn_ledge(4.0f, 1.0f, aabb);
+	RunFrames(3);
+	MCG_CHECK(std::fabs(bottom_of(l.faller) - kLedgeHalf) < kTolerance);
+	MCG_CHECK(std::fabs(x_of(l.faller) - (l.start_x + 2.0f)) < kTolerance); // f2、f3 各 1 px
+}
+
+// 从侧面水平撞上平台：沿 -vel 回退到侧面，不会被抬到顶面
+void side_hit_stops_at_wall(bool aabb)
+{
+	ResetWorld();
+	ObjManager& objs = ObjManager::Instance();
+	ObjManager::ObjToken ledge = Spawn({ .id = 1, .pos = { 0.0f, 0.0f }, .half = { kLedgeHalf, kLedgeHalf },
+		.kind = BodyKind::STATIC, .collider = ColliderType::SOLID });
+	ObjManager::ObjToken mover = Spawn({ .id = 2, .pos = { -40.0f, 0.0f }, .half = { kHalf, kHalf }, .vel = { 6.0f, 0.0f } });
+	objs[mover].ExcludeWithSolids(true);
+	if (aabb) {
+		keep_aabb(ledge);
+		keep_aabb(mover);
+	}
+	RunFrames(6);
+	MCG_CHECK(!EventsOf(2).empty());
+	MCG_CHECK(std::fabs(x_of(mover) + kHalf - (-kLedgeHalf)) < kTolerance);
+	MCG_CHECK(std::fabs(objs[mover].GetPosition().y) < kTolerance);
+}
+
+} // namespace
+
+int main()
+{
+	for (bool aabb : { false, true }) {
+		lands_on_ledge(aabb);
+		lands_while_moving_outward(aabb);
+		side_hit_stops_at_wall(aabb);
+	}
+	return Finish("solid_exclusion_test");
+}
@@ -0,0 +1,133 @@
+// 标签查询（user-025）：FindTokensByTag / FindAllTokensByTag 在对象提交、运行期增删标签、销毁与整体清空之后的结果
+#include "test_common.h"
+
+#include <algorithm>
+
+using namespace test;
+
+namespace {
+
+// OnDestroy 中给自己加标签的对象：注销必须按最终掩码进行，成员表里不能留下悬挂的下标
+class TagOnDestroy : public Probe {
+public:
+	using Probe::Probe;
+	void OnDestroy() noexcept override { AddTag("late"); }
+};
+
+std::vector<int> ids_with(const std::string& tag)
+{
+	ObjManager& objs = ObjManager::Instance();
+	std::vector<ObjManager::ObjToken> tokens;
+	objs.FindAllTokensByTag(tag, tokens);
+	std::vector<int> ids;
+	for (const ObjManager::ObjToken& t : tokens) {
+		MCG_CHECK(t.isRegitsered);
+		MCG_CHECK(objs.IsValid(t));
+		if (const Probe* p = dynamic_cast<const Probe*>(&objs[t])) ids.push_back(p->Id());
+	}
+	std::sort(ids.begin(), ids.end());
+	return ids;
+}
+
+int first_id_with(const std::string& tag)
+{
+	ObjManager& objs = ObjManager::Instance();
+	const ObjManager::ObjToken t = objs.FindTokensByTag(tag);
+	if (!objs.IsValid(t)) return -1;
+	const Probe* p = dynamic_cast<const Probe*>(&objs[t]);
+	return p ? p->Id() : -1;
+}
+
+BaseObject& object(ObjManager::ObjToken token) { return ObjManager::Instance()[token]; }
+
+// pending 对象的标签在提交时登记；FindTokensByTag 返回 index 最小者
+void found_after_commit()
+{
+	ResetWorld();
+	ObjManager::ObjToken a = Spawn({ .id = 1 });
+	ObjManager::ObjToken b = Spawn({ .id = 2 });
+	Spawn({ .id = 3 });
+	object(a).AddTag("enemy");
+	object(b).AddTag("enemy");
+	object(b).AddTag("boss");
+	MCG_CHECK_EQ(first_id_with("enemy"), -1);
+	MCG_CHECK(ids_with("enemy").empty());
+
+	RunFrames(1);
+	MCG_CHECK(ids_with("enemy") == std::vector<int>({ 1, 2 }));
+	MCG_CHECK(ids_with("boss") == std::vector<int>({ 2 }));
+	MCG_CHECK_EQ(first_id_with("enemy"), 1);
+	MCG_CHECK_EQ(first_id_with("boss"), 2);
+	MCG_CHECK_EQ(first_id_with("never-interned-tag"), -1);
+	MCG_CHECK(ids_with("never-interned-tag").empty());
+}
+
+// 已注册对象运行期间的 AddTag / RemoveTag 立即反映到查询
+void add_and_remove_at_runtime()
+{
+	ResetWorld();
+	ObjManager::ObjToken a = Spawn({ .id = 1 });
+	ObjManager::ObjToken b = Spawn({ .id = 2 });
+	RunFrames(1);
+	ObjManager::Instance().TryGetRegisteration(a);
+	ObjManager::Instance().TryGetRegisteration(b);
+
+	object(b).AddTag("key");
+	MCG_CHECK(ids_with("key") == std::vector<int>({ 2 }));
+	object(a).AddTag("key");
+	object(a).AddTag("key"); // 重复添加不产生重复成员
+	MCG_CHECK(ids_with("key") == std::vector<int>({ 1, 2 }));
+	MCG_CHECK_EQ(first_id_with("key"), 1);
+
+	object(a).RemoveTag("key");
+	MCG_CHECK(ids_with("key") == std::vector<int>({ 2 }));
+	MCG_CHECK_EQ(first_id_with("key"), 2);
+	object(b).RemoveTag("key");
+	MCG_CHECK(ids_with("key").empty());
+	MCG_CHECK_EQ(first_id_with("key"), -1);
+}
+
+// 销毁后不再被找到；同一槽位复用给没有该标签的新对象时也不会被误报
+void destroyed_objects_disappear()
+{
+	ResetWorld();
+	ObjManager& objs = ObjManager::Instance();
+	ObjManager::ObjToken a = Spawn({ .id = 1 });
+	ObjManager::ObjToken b = Spawn({ .id = 2 });
+	object(a).AddTag("coin");
+	object(b).AddTag("coin");
+	RunFrames(1);
+
+	objs.Destroy(a);
+	MCG_CHECK(ids_with("coin") == std::vector<int>({ 1, 2 })); // 延迟销毁：本帧仍存活
+	RunFrames(1);
+	MCG_CHECK(ids_with("coin") == std::vector<int>({ 2 }));
+	MCG_CHECK_EQ(first_id_with("coin"), 2);
+
+	Spawn({ .id = 3 }); // 复用 a 的槽位
+	RunFrames(1);
+	MCG_CHECK(ids_with("coin") == std::vector<int>({ 2 }));
+
+	// OnDestroy 中追加的标签同样被注销
+	ObjManager::ObjToken c = objs.Create<TagOnDestroy>(ProbeDesc{ .id = 4 });
+	object(c).AddTag("coin");
+	RunFrames(1);
+	objs.Destroy(c);
+	RunFrames(1);
+	MCG_CHECK(ids_with("coin") == std::vector<int>({ 2 }));
+	MCG_CHECK(ids_with("late").empty());
+
+	objs.DestroyAll();
+	MCG_CHECK(ids_with("coin").empty());
+	MCG_CHECK_EQ(first_id_with("coin"), -1);
+}
+
+} // namespace
+
+int main()
+{
+	found_after_commit();
+	add_and_remove_at_runtime();
+	destroyed_objects_disappear();
+	return Finish("tag_query_test");
+}
@@ -0,0 +1,202 @@
+#pragma once
+
+// 无窗口测试的公共工具：
+// - MCG_CHECK / MCG_CHECK_EQ：失败时打印位置并计数，不中断当前用例；Finish() 按失败数决定退出码
+// - Probe：按 ProbeDesc 配置形状、分类与速度的测试对象，把收到的 Enter/Stay/Exit 记入 g_events
+// - RunFrames / ResetWorld：按主循环的逻辑步顺序驱动（BeginStep、main_thread_on_update、UpdateAll），以及在用例之间清空对象和物理系统设置
+// - SpawnRandomScene：可复现的混合场景，用于比较不同配置下的事件序列
+#include "base_object.h"
+#include "base_physics.h"
+#include "delegate.h"
+#include "obj_manager.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace test {
+
+inline int g_failures = 0;
+inline int g_frame = 0; // RunFrames 已执行的帧数（ResetWorld 清零）
+
+#define MCG_CHECK(expr) \
+	do { \
+		if (!(expr)) { \
+			std::printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #expr); \
+			++::test::g_failures; \
+		} \
+	} while (0)
+
+#define MCG_CHECK_EQ(a, b) \
+	do { \
+		const long long mcg_a_ = static_cast<long long>(a); \
+		const long long mcg_b_ = static_cast<long long>(b); \
+		if (mcg_a_ != mcg_b_) { \
+			std::printf("%s:%d: CHECK_EQ failed: %s (%lld) != %s (%lld)\n", __FILE__, __LINE__, #a, mcg_a_, #b, mcg_b_); \
+			++::test::g_failures; \
+		} \
+	} while (0)
+
+// 一条碰撞事件：第几帧、阶段（'E' / 'S' / 'X'）、接收方与对方的 Probe id（对方不是 Probe 或已失效时为 -1）
+struct ContactEvent {
+	int frame = 0;
+	char phase = 0;
+	int self = 0;
+	int other = 0;
+	bool operator==(const ContactEvent& o) const noexcept
+	{
+		return frame == o.frame && phase == o.phase && self == o.self && other == o.other;
+	}
+};
+
+inline std::vector<ContactEvent> g_events;
+
+struct ProbeDesc {
+	int id = 0;
+	CF_V2 pos{ 0.0f, 0.0f };
+	CF_V2 half{ 8.0f, 8.0f };
+	BodyKind kind = BodyKind::DYNAMIC;
+	ColliderType collider = ColliderType::LIQUID; // 与 BasePhysics 默认值一致；连续碰撞只对 SOLID 目标生效
+	CF_V2 vel{ 0.0f, 0.0f };
+	bool triangle = false; // 以 half 为半宽/半高的朝上三角形，否则为 AABB
+	bool continuous = false;
+	uint32_t category = CollisionLayer::DEFAULT;
+	uint32_t mask = CollisionLayer::ALL;
+};
+
+class Probe : public BaseObject {
+public:
+	explicit Probe(const ProbeDesc& desc) noexcept : desc_(desc) {}
+
+	void Start() override
+	{
+		if (desc_.triangle) {
+			SetCenteredPoly({ { -desc_.half.x, -desc_.half.y }, { desc_.half.x, -desc_.half.y }, { 0.0f, desc_.half.y } });
+		}
+		else {
+			SetCenteredAabb(desc_.half.x, desc_.half.y);
+		}
+		SetBodyKind(desc_.kind);
+		SetColliderType(desc_.collider);
+		SetCollisionLayer(desc_.category, desc_.mask);
+		SetContinuousCollision(desc_.continuous);
+		SetPosition(desc_.pos);
+		SetVelocity(desc_.vel);
+	}
+
+	void OnCollisionEnter(const ObjManager::ObjToken& other, const CF_Manifold& manifold) noexcept override { record('E', other); (void)manifold; }
+	void OnCollisionStay(const ObjManager::ObjToken& other, const CF_Manifold& manifold) noexcept override { record('S', other); (void)manifold; }
+	void OnCollisionExit(const ObjManager::ObjToken& other, const CF_Manifold& manifold) noexcept override { record('X', other); (void)manifold; }
+
+	int Id() const noexcept { return desc_.id; }
+	ObjManager::ObjToken Token() const noexcept { return GetObjToken(); }
+
+private:
+	void record(char phase, const ObjManager::ObjToken& other) noexcept
+	{
+		int other_id = -1;
+		ObjManager& objs = ObjManager::Instance();
+		if (objs.IsValid(other)) {
+			if (const Probe* p = dynamic_cast<const Probe*>(&objs[other])) other_id = p->Id();
+		}
+		g_events.push_back(ContactEvent{ g_frame, phase, desc_.id, other_id });
+	}
+
+	ProbeDesc desc_;
+};
+
+inline ObjManager::ObjToken Spawn(const ProbeDesc& desc)
+{
+	return ObjManager::Instance().Create<Probe>(desc);
+}
+
+inline void RunFrames(int frames)
+{
+	for (int i = 0; i < frames; ++i) {
+		++g_frame;
+		ObjManager::Instance().BeginStep();
+		main_thread_on_update();
+		ObjManager::Instance().UpdateAll();
+	}
+}
+
+// 清空全部对象与事件，并把 PhysicsSystem 的可调设置恢复为默认值（GRID、串行 narrowphase）
+inline void ResetWorld()
+{
+	ObjManager::Instance().DestroyAll();
+	PhysicsSystem::Instance().SetBroadphaseMode(BroadphaseMode::GRID);
+	PhysicsSystem::Instance().SetWorkerThreads(0);
+	g_events.clear();
+	g_frame = 0;
+}
+
+// 可复现的混合场景（同一 seed 生成完全相同的对象与创建顺序），id 从 1 开始连续编号：
+// - static_count 个静态瓦片铺在 36 px 格子上（每行 20 格），约 1/4 为三角形尖刺
+// - mover_count 个运动体随机分布在瓦片区域内并带有恒定速度：约 1/5 为三角形，约 1/10 为 KINEMATIC，
+//   约 1/10 为只与 TERRAIN 互相接受的 PROJECTILE（瓦片中三角形之外的方块属于 TERRAIN）
+inline void SpawnRandomScene(uint32_t seed, int static_count, int mover_count)
+{
+	constexpr float kTile = 36.0f;
+	constexpr int kCols = 20;
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+	int id = 1;
+	for (int i = 0; i < static_count; ++i) {
+		ProbeDesc d;
+		d.id = id++;
+		d.pos = cf_v2((static_cast<float>(i % kCols) + 0.5f) * kTile, (static_cast<float>(i / kCols) + 0.5f) * kTile);
+		d.half = cf_v2(kTile * 0.5f, kTile * 0.5f);
+		d.kind = BodyKind::STATIC;
+		d.triangle = unit(rng) < 0.25f;
+		d.category = d.triangle ? CollisionLayer::HAZARD : CollisionLayer::TERRAIN;
+		Spawn(d);
+	}
+	const float width = kCols * kTile;
+	const float height = static_cast<float>((static_count + kCols - 1) / kCols) * kTile;
+	for (int i = 0; i < mover_count; ++i) {
+		ProbeDesc d;
+		d.id = id++;
+		d.pos = cf_v2(unit(rng) * width, unit(rng) * height);
+		d.half = cf_v2(4.0f + unit(rng) * 10.0f, 4.0f + unit(rng) * 10.0f);
+		d.vel = cf_v2((unit(rng) - 0.5f) * 12.0f, (unit(rng) - 0.5f) * 12.0f);
+		d.triangle = unit(rng) < 0.2f;
+		const float role = unit(rng);
+		if (role < 0.1f) {
+			d.kind = BodyKind::KINEMATIC;
+		}
+		else if (role < 0.2f) {
+			d.category = CollisionLayer::PROJECTILE;
+			d.mask = CollisionLayer::TERRAIN;
+		}
+		Spawn(d);
+	}
+}
+
+// 只保留某个对象收到的事件，便于逐帧比对
+inline std::vector<ContactEvent> EventsOf(int id)
+{
+	std::vector<ContactEvent> out;
+	for (const ContactEvent& e : g_events) {
+		if (e.self == id) out.push_back(e);
+	}
+	return out;
+}
+
+inline void PrintEvents(const char* label, const std::vector<ContactEvent>& events)
+{
+	std::printf("%s:", label);
+	for (const ContactEvent& e : events) std::printf(" [f%d %c %d<-%d]", e.frame, e.phase, e.self, e.other);
+	std::printf("\n");
+}
+
+// 结束测试程序：清空对象（避免静态析构顺序问题），打印结果并返回退出码
+inline int Finish(const char* name)
+{
+	ObjManager::Instance().DestroyAll();
+	if (g_failures == 0) std::printf("%s: all checks passed\n", name);
+	else std::printf("%s: %d check(s) failed\n", name, g_failures);
+	return g_failures == 0 ? 0 : 1;
+}
+
+} // namespace test